@@ -19,6 +19,9 @@ set(use_sse4_2 $<BOOL:${GDJ_USE_SSE4_2}>)
 
 set(is_double_precision $<BOOL:${GDJ_DOUBLE_PRECISION}>)
 
+# Also used by the shape cache, to tell apart shapes cooked by different versions of Jolt
+set(jolt_commit 39443fca4927ef98e88e436a503139d4752871f2)
+
 set(is_msvc_cl $<CXX_COMPILER_ID:MSVC>)
 
 set(dev_definitions
@@ -35,7 +38,7 @@ endif()
 
 gdj_add_external_library(jolt "${configurations}"
 	GIT_REPOSITORY https://github.com/godot-jolt/jolt.git
-	GIT_COMMIT 39443fca4927ef98e88e436a503139d4752871f2
+	GIT_COMMIT ${jolt_commit}
 	LANGUAGE CXX
 	SOURCE_SUBDIR Build
 	OUTPUT_NAME Jolt
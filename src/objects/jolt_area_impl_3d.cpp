@@ -49,6 +49,8 @@ void JoltAreaImpl3D::set_transform(const Transform3D& p_transform) {
 			to_jolt(new_transform.basis),
 			JPH::EActivation::DontActivate
 		);
+
+		space->invalidate_query_cache();
 	}
 }
 
@@ -180,6 +182,68 @@ void JoltAreaImpl3D::set_param(PhysicsServer3D::AreaParameter p_param, const Var
 	}
 }
 
+Variant JoltAreaImpl3D::get_jolt_param(JoltParameter p_param) const {
+	switch (p_param) {
+		case JoltPhysicsServer3DExtension::AREA_BUOYANCY_SURFACE: {
+			return get_buoyancy_surface();
+		}
+		case JoltPhysicsServer3DExtension::AREA_BUOYANCY_FLUID_DENSITY: {
+			return get_buoyancy_fluid_density();
+		}
+		case JoltPhysicsServer3DExtension::AREA_BUOYANCY_LINEAR_DRAG: {
+			return get_buoyancy_linear_drag();
+		}
+		case JoltPhysicsServer3DExtension::AREA_BUOYANCY_ANGULAR_DRAG: {
+			return get_buoyancy_angular_drag();
+		}
+		default: {
+			ERR_FAIL_D_REPORT(vformat("Unhandled parameter: '%d'.", p_param));
+		}
+	}
+}
+
+void JoltAreaImpl3D::set_jolt_param(JoltParameter p_param, const Variant& p_value) {
+	switch (p_param) {
+		case JoltPhysicsServer3DExtension::AREA_BUOYANCY_SURFACE: {
+			set_buoyancy_surface(((Plane)p_value).normalized());
+		} break;
+		case JoltPhysicsServer3DExtension::AREA_BUOYANCY_FLUID_DENSITY: {
+			set_buoyancy_fluid_density(p_value);
+		} break;
+		case JoltPhysicsServer3DExtension::AREA_BUOYANCY_LINEAR_DRAG: {
+			set_buoyancy_linear_drag(p_value);
+		} break;
+		case JoltPhysicsServer3DExtension::AREA_BUOYANCY_ANGULAR_DRAG: {
+			set_buoyancy_angular_drag(p_value);
+		} break;
+		default: {
+			ERR_FAIL_REPORT(vformat("Unhandled parameter: '%d'.", p_param));
+		} break;
+	}
+}
+
+bool JoltAreaImpl3D::get_jolt_flag(JoltFlag p_flag) const {
+	switch (p_flag) {
+		case JoltPhysicsServer3DExtension::AREA_FLAG_ENABLE_BUOYANCY: {
+			return is_buoyancy_enabled();
+		}
+		default: {
+			ERR_FAIL_D_REPORT(vformat("Unhandled flag: '%d'.", p_flag));
+		}
+	}
+}
+
+void JoltAreaImpl3D::set_jolt_flag(JoltFlag p_flag, bool p_enabled) {
+	switch (p_flag) {
+		case JoltPhysicsServer3DExtension::AREA_FLAG_ENABLE_BUOYANCY: {
+			set_buoyancy_enabled(p_enabled);
+		} break;
+		default: {
+			ERR_FAIL_REPORT(vformat("Unhandled flag: '%d'.", p_flag));
+		} break;
+	}
+}
+
 void JoltAreaImpl3D::set_body_monitor_callback(const Callable& p_callback) {
 	if (p_callback == body_monitor_callback) {
 		return;
@@ -307,6 +371,34 @@ Vector3 JoltAreaImpl3D::compute_gravity(const Vector3& p_position) const {
 	return to_point_dir * (gravity * gravity_dist_sq / to_point_dist_sq);
 }
 
+void JoltAreaImpl3D::apply_buoyancy(
+	float p_step,
+	JPH::Body& p_jolt_body,
+	const Vector3& p_gravity
+) const {
+	const float volume = p_jolt_body.GetShape()->GetVolume();
+	const float inverse_mass = p_jolt_body.GetMotionPropertiesUnchecked()->GetInverseMass();
+
+	if (volume <= 0.0f || inverse_mass <= 0.0f) {
+		return;
+	}
+
+	// Jolt expects the buoyancy to be a factor relative to the density of the body itself, so we
+	// convert from the absolute fluid density here, which ends up being more intuitive to tweak.
+	const float buoyancy = buoyancy_fluid_density * volume * inverse_mass;
+
+	p_jolt_body.ApplyBuoyancyImpulse(
+		buoyancy_surface_position,
+		buoyancy_surface_normal,
+		buoyancy,
+		buoyancy_linear_drag,
+		buoyancy_angular_drag,
+		JPH::Vec3::sZero(),
+		to_jolt(p_gravity),
+		p_step
+	);
+}
+
 void JoltAreaImpl3D::body_shape_entered(
 	const JPH::BodyID& p_body_id,
 	const JPH::SubShapeID& p_other_shape_id,
@@ -409,6 +501,27 @@ void JoltAreaImpl3D::call_queries([[maybe_unused]] JPH::Body& p_jolt_body) {
 	_flush_events(areas_by_id, area_monitor_callback);
 }
 
+void JoltAreaImpl3D::pre_step(float p_step, JPH::Body& p_jolt_body) {
+	JoltShapedObjectImpl3D::pre_step(p_step, p_jolt_body);
+
+	if (!buoyancy_enabled) {
+		return;
+	}
+
+	// We resolve the surface into world space once per step here, rather than once per body that
+	// is overlapping the area, which also means that the jobs applying the buoyancy never need to
+	// read from this area's underlying Jolt body.
+	const JPH::RMat44 transform = p_jolt_body.GetWorldTransform();
+	const Vector3 surface_position = buoyancy_surface.get_center() * scale;
+
+	// Normals don't scale the same way that positions do, so under non-uniform scaling we need to
+	// apply the inverse scale to the normal in order for it to stay perpendicular to the surface.
+	const Vector3 surface_normal = (buoyancy_surface.normal / scale).normalized();
+
+	buoyancy_surface_position = transform * to_jolt(surface_position);
+	buoyancy_surface_normal = transform.Multiply3x3(to_jolt(surface_normal));
+}
+
 JPH::BroadPhaseLayer JoltAreaImpl3D::_get_broad_phase_layer() const {
 	return monitorable
 		? JoltBroadPhaseLayer::AREA_DETECTABLE
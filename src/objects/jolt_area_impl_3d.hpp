@@ -1,6 +1,7 @@
 #pragma once
 
 #include "objects/jolt_shaped_object_impl_3d.hpp"
+#include "servers/jolt_physics_server_3d.hpp"
 
 class JoltBodyImpl3D;
 class JoltSoftBodyImpl3D;
@@ -73,6 +74,10 @@ class JoltAreaImpl3D final : public JoltShapedObjectImpl3D {
 public:
 	using OverrideMode = PhysicsServer3D::AreaSpaceOverrideMode;
 
+	using JoltParameter = JoltPhysicsServer3DExtension::AreaParamJolt;
+
+	using JoltFlag = JoltPhysicsServer3DExtension::AreaFlagJolt;
+
 	JoltAreaImpl3D();
 
 	bool is_default_area() const;
@@ -85,6 +90,14 @@ public:
 
 	void set_param(PhysicsServer3D::AreaParameter p_param, const Variant& p_value);
 
+	Variant get_jolt_param(JoltParameter p_param) const;
+
+	void set_jolt_param(JoltParameter p_param, const Variant& p_value);
+
+	bool get_jolt_flag(JoltFlag p_flag) const;
+
+	void set_jolt_flag(JoltFlag p_flag, bool p_enabled);
+
 	bool has_body_monitor_callback() const { return body_monitor_callback.is_valid(); }
 
 	void set_body_monitor_callback(const Callable& p_callback);
@@ -155,6 +168,28 @@ public:
 
 	Vector3 compute_gravity(const Vector3& p_position) const;
 
+	bool is_buoyancy_enabled() const { return buoyancy_enabled; }
+
+	void set_buoyancy_enabled(bool p_enabled) { buoyancy_enabled = p_enabled; }
+
+	const Plane& get_buoyancy_surface() const { return buoyancy_surface; }
+
+	void set_buoyancy_surface(const Plane& p_surface) { buoyancy_surface = p_surface; }
+
+	float get_buoyancy_fluid_density() const { return buoyancy_fluid_density; }
+
+	void set_buoyancy_fluid_density(float p_density) { buoyancy_fluid_density = p_density; }
+
+	float get_buoyancy_linear_drag() const { return buoyancy_linear_drag; }
+
+	void set_buoyancy_linear_drag(float p_drag) { buoyancy_linear_drag = p_drag; }
+
+	float get_buoyancy_angular_drag() const { return buoyancy_angular_drag; }
+
+	void set_buoyancy_angular_drag(float p_drag) { buoyancy_angular_drag = p_drag; }
+
+	void apply_buoyancy(float p_step, JPH::Body& p_jolt_body, const Vector3& p_gravity) const;
+
 	void body_shape_entered(
 		const JPH::BodyID& p_body_id,
 		const JPH::SubShapeID& p_other_shape_id,
@@ -191,6 +226,8 @@ public:
 
 	void call_queries(JPH::Body& p_jolt_body);
 
+	void pre_step(float p_step, JPH::Body& p_jolt_body) override;
+
 	bool has_custom_center_of_mass() const override { return false; }
 
 	Vector3 get_center_of_mass_custom() const override { return {0, 0, 0}; }
@@ -262,6 +299,12 @@ private:
 
 	Vector3 gravity_vector = {0, -1, 0};
 
+	Plane buoyancy_surface = {Vector3(0, 1, 0), 0};
+
+	JPH::RVec3 buoyancy_surface_position = JPH::RVec3::sZero();
+
+	JPH::Vec3 buoyancy_surface_normal = JPH::Vec3::sAxisY();
+
 	Callable body_monitor_callback;
 
 	Callable area_monitor_callback;
@@ -276,6 +319,12 @@ private:
 
 	float angular_damp = 0.1f;
 
+	float buoyancy_fluid_density = 1.0f;
+
+	float buoyancy_linear_drag = 0.5f;
+
+	float buoyancy_angular_drag = 0.05f;
+
 	OverrideMode gravity_mode = PhysicsServer3D::AREA_SPACE_OVERRIDE_DISABLED;
 
 	OverrideMode linear_damp_mode = PhysicsServer3D::AREA_SPACE_OVERRIDE_DISABLED;
@@ -285,4 +334,6 @@ private:
 	bool monitorable = false;
 
 	bool point_gravity = false;
+
+	bool buoyancy_enabled = false;
 };
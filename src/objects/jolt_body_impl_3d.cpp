@@ -75,6 +75,8 @@ void JoltBodyImpl3D::set_transform(Transform3D p_transform) {
 			to_jolt(p_transform.basis),
 			JPH::EActivation::DontActivate
 		);
+
+		space->invalidate_query_cache();
 	}
 
 	_transform_changed();
@@ -466,6 +468,19 @@ bool JoltBodyImpl3D::reports_all_kinematic_contacts() const {
 	return reports_contacts() && JoltProjectSettings::report_all_kinematic_contacts();
 }
 
+JoltBodyImpl3D::RecoveryCache JoltBodyImpl3D::get_recovery_cache() const {
+	const MutexLock lock(recovery_cache_mutex);
+	return recovery_cache;
+}
+
+void JoltBodyImpl3D::set_recovery_cache(RecoveryCache p_cache) const {
+	// This is only ever written to by motion tests, which operate on const bodies, and since it's
+	// merely a cache there's no harm in it being mutable. The lock is there for the benefit of
+	// `body_test_motions`, which could end up testing the same body on several threads at once.
+	const MutexLock lock(recovery_cache_mutex);
+	recovery_cache = std::move(p_cache);
+}
+
 void JoltBodyImpl3D::add_contact(
 	const JoltBodyImpl3D* p_collider,
 	float p_depth,
@@ -858,6 +873,21 @@ void JoltBodyImpl3D::pre_step(float p_step, JPH::Body& p_jolt_body) {
 	contact_count = 0;
 }
 
+bool JoltBodyImpl3D::is_buoyant(const JPH::Body& p_jolt_body) const {
+	if (!is_rigid() || custom_integrator || !p_jolt_body.IsActive()) {
+		return false;
+	}
+
+	return _get_buoyancy_area() != nullptr;
+}
+
+void JoltBodyImpl3D::apply_buoyancy(float p_step, JPH::Body& p_jolt_body) const {
+	const JoltAreaImpl3D* area = _get_buoyancy_area();
+	QUIET_FAIL_NULL(area);
+
+	area->apply_buoyancy(p_step, p_jolt_body, gravity);
+}
+
 JoltPhysicsDirectBodyState3DExtension* JoltBodyImpl3D::get_direct_state() {
 	if (direct_state == nullptr) {
 		direct_state = memnew(JoltPhysicsDirectBodyState3DExtension(this));
@@ -1410,6 +1440,18 @@ void JoltBodyImpl3D::_update_damp() {
 	}
 }
 
+const JoltAreaImpl3D* JoltBodyImpl3D::_get_buoyancy_area() const {
+	// Since the areas are sorted by priority we only ever let the highest priority one apply its
+	// buoyancy, as applying several of them would mean the body floats more than it should.
+	for (const JoltAreaImpl3D* area : areas) {
+		if (area->is_buoyancy_enabled()) {
+			return area;
+		}
+	}
+
+	return nullptr;
+}
+
 void JoltBodyImpl3D::_update_kinematic_transform() {
 	if (is_kinematic()) {
 		kinematic_transform = get_transform_unscaled();
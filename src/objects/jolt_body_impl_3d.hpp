@@ -8,6 +8,10 @@ class JoltJointImpl3D;
 class JoltSoftBodyImpl3D;
 
 class JoltBodyImpl3D final : public JoltShapedObjectImpl3D {
+	using Mutex = std::mutex;
+
+	using MutexLock = std::unique_lock<Mutex>;
+
 public:
 	using DampMode = PhysicsServer3D::BodyDampMode;
 
@@ -35,6 +39,51 @@ public:
 		Vector3 impulse;
 	};
 
+	struct RecoveryNeighbor {
+		friend bool operator==(const RecoveryNeighbor& p_lhs, const RecoveryNeighbor& p_rhs) {
+			return p_lhs.jolt_id == p_rhs.jolt_id && p_lhs.position == p_rhs.position &&
+				p_lhs.rotation == p_rhs.rotation && p_lhs.jolt_shape == p_rhs.jolt_shape &&
+				p_lhs.shape_revision == p_rhs.shape_revision &&
+				p_lhs.object_layer == p_rhs.object_layer && p_lhs.priority == p_rhs.priority;
+		}
+
+		JPH::BodyID jolt_id;
+
+		JPH::RVec3 position;
+
+		JPH::Quat rotation;
+
+		JPH::ShapeRefC jolt_shape;
+
+		JPH::ObjectLayer object_layer = 0;
+
+		uint32_t shape_revision = 0;
+
+		float priority = 0.0f;
+	};
+
+	using RecoveryNeighbors = InlineVector<RecoveryNeighbor, 8>;
+
+	// The outcome of the last depenetration done on behalf of `body_test_motion`, along with
+	// everything that went into it, so that it can be reused for as long as nothing has changed.
+	struct RecoveryCache {
+		RecoveryNeighbors neighbors;
+
+		JPH::ShapeRefC jolt_shape;
+
+		Transform3D transform;
+
+		Vector3 recovery;
+
+		float margin = 0.0f;
+
+		float travel = 0.0f;
+
+		uint32_t shape_revision = 0;
+
+		bool recovered = false;
+	};
+
 	JoltBodyImpl3D();
 
 	~JoltBodyImpl3D() override;
@@ -108,6 +157,10 @@ public:
 
 	bool reports_all_kinematic_contacts() const;
 
+	RecoveryCache get_recovery_cache() const;
+
+	void set_recovery_cache(RecoveryCache p_cache) const;
+
 	void add_contact(
 		const JoltBodyImpl3D* p_collider,
 		float p_depth,
@@ -173,6 +226,10 @@ public:
 
 	void pre_step(float p_step, JPH::Body& p_jolt_body) override;
 
+	bool is_buoyant(const JPH::Body& p_jolt_body) const;
+
+	void apply_buoyancy(float p_step, JPH::Body& p_jolt_body) const;
+
 	JoltPhysicsDirectBodyState3DExtension* get_direct_state();
 
 	PhysicsServer3D::BodyMode get_mode() const { return mode; }
@@ -286,6 +343,8 @@ private:
 
 	void _update_damp();
 
+	const JoltAreaImpl3D* _get_buoyancy_area() const;
+
 	void _update_kinematic_transform();
 
 	void _update_group_filter();
@@ -328,6 +387,10 @@ private:
 
 	LocalVector<JoltJointImpl3D*> joints;
 
+	mutable RecoveryCache recovery_cache;
+
+	mutable Mutex recovery_cache_mutex;
+
 	Variant custom_integration_userdata;
 
 	Transform3D kinematic_transform;
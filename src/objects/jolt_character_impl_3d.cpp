@@ -0,0 +1,361 @@
+#include "jolt_character_impl_3d.hpp"
+
+#include "objects/jolt_area_impl_3d.hpp"
+#include "objects/jolt_body_impl_3d.hpp"
+#include "shapes/jolt_shape_impl_3d.hpp"
+#include "spaces/jolt_query_filter_3d.hpp"
+#include "spaces/jolt_space_3d.hpp"
+
+JoltCharacterImpl3D::JoltCharacterImpl3D()
+	: body(memnew(JoltBodyImpl3D)) {
+	// `CharacterVirtual` doesn't exist in the physics system, so nothing would otherwise be able to
+	// collide with it. We pair it with a kinematic body that follows it around, which lets rigid
+	// bodies and other characters (as well as regular queries) treat it as a solid obstacle.
+	body->set_mode(PhysicsServer3D::BODY_MODE_KINEMATIC);
+	body->set_collision_layer(collision_layer);
+	body->set_collision_mask(collision_mask);
+}
+
+JoltCharacterImpl3D::~JoltCharacterImpl3D() {
+	if (shape != nullptr) {
+		shape->remove_character(this);
+	}
+
+	memdelete_safely(body);
+}
+
+void JoltCharacterImpl3D::set_rid(const RID& p_rid) {
+	rid = p_rid;
+
+	// The body shares the character's RID, so that anything hitting it is reported as having hit
+	// the character, and so that the character can exclude its own body from its movement.
+	body->set_rid(rid);
+
+	excluded_objects.clear();
+	excluded_objects.insert(rid);
+}
+
+void JoltCharacterImpl3D::set_space(JoltSpace3D* p_space) {
+	if (space == p_space) {
+		return;
+	}
+
+	if (space != nullptr) {
+		_destroy_in_space();
+		space->remove_character(this);
+	}
+
+	space = p_space;
+
+	body->set_space(space);
+
+	if (space != nullptr) {
+		space->add_character(this);
+		_create_in_space();
+	}
+}
+
+RID JoltCharacterImpl3D::get_shape() const {
+	return shape != nullptr ? shape->get_rid() : RID();
+}
+
+void JoltCharacterImpl3D::set_shape(JoltShapeImpl3D* p_shape) {
+	ERR_FAIL_COND_MSG(
+		p_shape != nullptr && !p_shape->is_convex(),
+		vformat(
+			"Failed to set shape of character with RID '%d'. "
+			"Only convex shapes are supported for characters.",
+			rid.get_id()
+		)
+	);
+
+	if (shape != nullptr) {
+		shape->remove_character(this);
+		body->remove_shape(shape);
+	}
+
+	shape = p_shape;
+
+	if (shape != nullptr) {
+		shape->add_character(this);
+		body->add_shape(shape, Transform3D(), false);
+	}
+
+	_shape_changed();
+}
+
+Transform3D JoltCharacterImpl3D::get_transform() const {
+	if (jolt_ref == nullptr) {
+		return transform;
+	}
+
+	return {to_godot(jolt_ref->GetRotation()), to_godot(jolt_ref->GetPosition())};
+}
+
+void JoltCharacterImpl3D::set_transform(const Transform3D& p_transform) {
+	// Characters can't be scaled, so we discard any scale rather than distorting the shape.
+	transform = p_transform.orthonormalized();
+
+	if (jolt_ref != nullptr) {
+		jolt_ref->SetPosition(to_jolt_r(transform.origin));
+		jolt_ref->SetRotation(to_jolt(transform.basis));
+	}
+
+	body->set_transform(transform);
+
+	if (body->in_space()) {
+		// Kinematic bodies are otherwise moved over the course of the next step, which would have
+		// the body sweep through everything in between, so we teleport it along with the character.
+		space->get_body_iface().SetPositionAndRotation(
+			body->get_jolt_id(),
+			to_jolt_r(transform.origin),
+			to_jolt(transform.basis),
+			JPH::EActivation::DontActivate
+		);
+
+		space->invalidate_query_cache();
+	}
+}
+
+Vector3 JoltCharacterImpl3D::get_velocity() const {
+	if (jolt_ref == nullptr) {
+		return velocity;
+	}
+
+	return to_godot(jolt_ref->GetLinearVelocity());
+}
+
+void JoltCharacterImpl3D::set_velocity(const Vector3& p_velocity) {
+	velocity = p_velocity;
+
+	if (jolt_ref != nullptr) {
+		jolt_ref->SetLinearVelocity(to_jolt(velocity));
+	}
+}
+
+void JoltCharacterImpl3D::set_collision_layer(uint32_t p_layer) {
+	collision_layer = p_layer;
+
+	body->set_collision_layer(collision_layer);
+}
+
+void JoltCharacterImpl3D::set_collision_mask(uint32_t p_mask) {
+	collision_mask = p_mask;
+
+	body->set_collision_mask(collision_mask);
+}
+
+double JoltCharacterImpl3D::get_jolt_param(JoltParameter p_param) const {
+	switch (p_param) {
+		case JoltPhysicsServer3DExtension::CHARACTER_MAX_SLOPE_ANGLE: {
+			return max_slope_angle;
+		}
+		case JoltPhysicsServer3DExtension::CHARACTER_STEP_HEIGHT: {
+			return step_height;
+		}
+		case JoltPhysicsServer3DExtension::CHARACTER_FLOOR_SNAP_LENGTH: {
+			return floor_snap_length;
+		}
+		case JoltPhysicsServer3DExtension::CHARACTER_MASS: {
+			return mass;
+		}
+		case JoltPhysicsServer3DExtension::CHARACTER_MAX_PUSH_FORCE: {
+			return max_push_force;
+		}
+		case JoltPhysicsServer3DExtension::CHARACTER_SAFE_MARGIN: {
+			return safe_margin;
+		}
+		default: {
+			ERR_FAIL_D_REPORT(vformat("Unhandled parameter: '%d'.", p_param));
+		}
+	}
+}
+
+void JoltCharacterImpl3D::set_jolt_param(JoltParameter p_param, double p_value) {
+	switch (p_param) {
+		case JoltPhysicsServer3DExtension::CHARACTER_MAX_SLOPE_ANGLE: {
+			max_slope_angle = (float)p_value;
+
+			if (jolt_ref != nullptr) {
+				jolt_ref->SetMaxSlopeAngle(max_slope_angle);
+			}
+		} break;
+		case JoltPhysicsServer3DExtension::CHARACTER_STEP_HEIGHT: {
+			step_height = MAX((float)p_value, 0.0f);
+		} break;
+		case JoltPhysicsServer3DExtension::CHARACTER_FLOOR_SNAP_LENGTH: {
+			floor_snap_length = MAX((float)p_value, 0.0f);
+		} break;
+		case JoltPhysicsServer3DExtension::CHARACTER_MASS: {
+			mass = (float)p_value;
+
+			if (jolt_ref != nullptr) {
+				jolt_ref->SetMass(mass);
+			}
+		} break;
+		case JoltPhysicsServer3DExtension::CHARACTER_MAX_PUSH_FORCE: {
+			max_push_force = (float)p_value;
+
+			if (jolt_ref != nullptr) {
+				jolt_ref->SetMaxStrength(max_push_force);
+			}
+		} break;
+		case JoltPhysicsServer3DExtension::CHARACTER_SAFE_MARGIN: {
+			safe_margin = (float)p_value;
+
+			// The padding is baked into the character when it's created, so we need to rebuild it.
+			_rebuild();
+		} break;
+		default: {
+			ERR_FAIL_REPORT(vformat("Unhandled parameter: '%d'.", p_param));
+		} break;
+	}
+}
+
+JoltCharacterImpl3D::JoltGroundState JoltCharacterImpl3D::get_ground_state() const {
+	if (jolt_ref == nullptr) {
+		return JoltPhysicsServer3DExtension::CHARACTER_GROUND_STATE_IN_AIR;
+	}
+
+	const JPH::CharacterBase::EGroundState ground_state = jolt_ref->GetGroundState();
+
+	switch (ground_state) {
+		case JPH::CharacterBase::EGroundState::OnGround: {
+			return JoltPhysicsServer3DExtension::CHARACTER_GROUND_STATE_ON_FLOOR;
+		}
+		case JPH::CharacterBase::EGroundState::OnSteepGround: {
+			return JoltPhysicsServer3DExtension::CHARACTER_GROUND_STATE_ON_STEEP_GROUND;
+		}
+		case JPH::CharacterBase::EGroundState::NotSupported: {
+			return JoltPhysicsServer3DExtension::CHARACTER_GROUND_STATE_NOT_SUPPORTED;
+		}
+		case JPH::CharacterBase::EGroundState::InAir: {
+			return JoltPhysicsServer3DExtension::CHARACTER_GROUND_STATE_IN_AIR;
+		}
+		default: {
+			ERR_FAIL_D_REPORT(vformat("Unhandled ground state: '%d'.", (int32_t)ground_state));
+		}
+	}
+}
+
+Vector3 JoltCharacterImpl3D::get_ground_normal() const {
+	if (jolt_ref == nullptr) {
+		return {};
+	}
+
+	return to_godot(jolt_ref->GetGroundNormal());
+}
+
+Vector3 JoltCharacterImpl3D::get_ground_velocity() const {
+	if (jolt_ref == nullptr) {
+		return {};
+	}
+
+	return to_godot(jolt_ref->GetGroundVelocity());
+}
+
+void JoltCharacterImpl3D::pre_step() {
+	const JoltAreaImpl3D* default_area = space->get_default_area();
+
+	if (default_area != nullptr) {
+		gravity = default_area->compute_gravity(get_transform().origin);
+	} else {
+		gravity = {};
+	}
+
+	// We let the direction of gravity dictate what's up, so that things like point gravity work as
+	// expected, but hold on to the previous direction if there's no gravity at all.
+	if (!gravity.is_zero_approx()) {
+		up = -gravity.normalized();
+	}
+
+	jolt_ref->SetUp(to_jolt(up));
+}
+
+void JoltCharacterImpl3D::update(float p_step, JPH::TempAllocator& p_temp_allocator) {
+	JoltQueryFilter3D query_filter(*space->get_direct_state(), collision_mask, true, false);
+	query_filter.set_excluded_objects(&excluded_objects);
+
+	const JPH::ShapeFilter shape_filter;
+
+	JPH::CharacterVirtual::ExtendedUpdateSettings settings;
+	settings.mStickToFloorStepDown = to_jolt(up * -floor_snap_length);
+	settings.mWalkStairsStepUp = to_jolt(up * step_height);
+
+	jolt_ref->ExtendedUpdate(
+		p_step,
+		to_jolt(gravity),
+		settings,
+		query_filter,
+		query_filter,
+		query_filter,
+		shape_filter,
+		p_temp_allocator
+	);
+}
+
+void JoltCharacterImpl3D::post_update(float p_step) {
+	const Transform3D new_transform = get_transform();
+
+	body->set_transform(new_transform);
+
+	if (!body->in_space()) {
+		return;
+	}
+
+	// The body would otherwise only be moved to its new transform as part of the next step, so we
+	// move it ourselves, which also gives it the velocity that any rigid bodies will collide with.
+	space->get_body_iface().MoveKinematic(
+		body->get_jolt_id(),
+		to_jolt_r(new_transform.origin),
+		to_jolt(new_transform.basis),
+		p_step
+	);
+}
+
+void JoltCharacterImpl3D::_shape_changed() {
+	// We hold on to the built shape, rather than building it every step, but since the shape can
+	// be modified after the fact we need to do this every time the shape tells us it has changed.
+	jolt_shape = shape != nullptr ? shape->try_build() : nullptr;
+
+	_rebuild();
+}
+
+void JoltCharacterImpl3D::_create_in_space() {
+	if (space == nullptr || jolt_shape == nullptr) {
+		return;
+	}
+
+	JPH::CharacterVirtualSettings settings;
+	settings.mShape = jolt_shape;
+	settings.mUp = to_jolt(up);
+	settings.mMaxSlopeAngle = max_slope_angle;
+	settings.mMass = mass;
+	settings.mMaxStrength = max_push_force;
+	settings.mCharacterPadding = safe_margin;
+
+	jolt_ref = new JPH::CharacterVirtual(
+		&settings,
+		to_jolt_r(transform.origin),
+		to_jolt(transform.basis),
+		&space->get_physics_system()
+	);
+
+	jolt_ref->SetLinearVelocity(to_jolt(velocity));
+}
+
+void JoltCharacterImpl3D::_destroy_in_space() {
+	if (jolt_ref == nullptr) {
+		return;
+	}
+
+	transform = get_transform();
+	velocity = get_velocity();
+
+	jolt_ref = nullptr;
+}
+
+void JoltCharacterImpl3D::_rebuild() {
+	_destroy_in_space();
+	_create_in_space();
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "servers/jolt_physics_server_3d.hpp"
+
+class JoltBodyImpl3D;
+class JoltShapeImpl3D;
+class JoltSpace3D;
+
+class JoltCharacterImpl3D {
+public:
+	using JoltParameter = JoltPhysicsServer3DExtension::CharacterParamJolt;
+
+	using JoltGroundState = JoltPhysicsServer3DExtension::CharacterGroundStateJolt;
+
+	JoltCharacterImpl3D();
+
+	~JoltCharacterImpl3D();
+
+	RID get_rid() const { return rid; }
+
+	void set_rid(const RID& p_rid);
+
+	JoltSpace3D* get_space() const { return space; }
+
+	void set_space(JoltSpace3D* p_space);
+
+	RID get_shape() const;
+
+	void set_shape(JoltShapeImpl3D* p_shape);
+
+	Transform3D get_transform() const;
+
+	void set_transform(const Transform3D& p_transform);
+
+	Vector3 get_velocity() const;
+
+	void set_velocity(const Vector3& p_velocity);
+
+	uint32_t get_collision_layer() const { return collision_layer; }
+
+	void set_collision_layer(uint32_t p_layer);
+
+	uint32_t get_collision_mask() const { return collision_mask; }
+
+	void set_collision_mask(uint32_t p_mask);
+
+	double get_jolt_param(JoltParameter p_param) const;
+
+	void set_jolt_param(JoltParameter p_param, double p_value);
+
+	JoltGroundState get_ground_state() const;
+
+	Vector3 get_ground_normal() const;
+
+	Vector3 get_ground_velocity() const;
+
+	bool is_valid() const { return jolt_ref != nullptr; }
+
+	void pre_step();
+
+	void update(float p_step, JPH::TempAllocator& p_temp_allocator);
+
+	void post_update(float p_step);
+
+private:
+	friend class JoltShapeImpl3D;
+
+	void _shape_changed();
+
+	void _create_in_space();
+
+	void _destroy_in_space();
+
+	void _rebuild();
+
+	JPH::Ref<JPH::CharacterVirtual> jolt_ref;
+
+	JPH::ShapeRefC jolt_shape;
+
+	HashSet<RID> excluded_objects;
+
+	RID rid;
+
+	Transform3D transform;
+
+	Vector3 velocity;
+
+	Vector3 gravity;
+
+	Vector3 up = Vector3(0.0f, 1.0f, 0.0f);
+
+	JoltShapeImpl3D* shape = nullptr;
+
+	JoltBodyImpl3D* body = nullptr;
+
+	JoltSpace3D* space = nullptr;
+
+	uint32_t collision_layer = 1;
+
+	uint32_t collision_mask = 1;
+
+	float max_slope_angle = Math::deg_to_rad(45.0f);
+
+	float step_height = 0.3f;
+
+	float floor_snap_length = 0.1f;
+
+	float mass = 70.0f;
+
+	float max_push_force = 100.0f;
+
+	float safe_margin = 0.02f;
+};
@@ -122,6 +122,7 @@ void JoltObjectImpl3D::_update_object_layer() {
 	}
 
 	space->get_body_iface().SetObjectLayer(jolt_id, _get_object_layer());
+	space->invalidate_query_cache();
 }
 
 void JoltObjectImpl3D::_collision_layer_changed() {
@@ -1,5 +1,6 @@
 #include "jolt_shaped_object_impl_3d.hpp"
 
+#include "servers/jolt_project_settings.hpp"
 #include "shapes/jolt_custom_double_sided_shape.hpp"
 #include "shapes/jolt_shape_impl_3d.hpp"
 #include "spaces/jolt_space_3d.hpp"
@@ -139,6 +140,9 @@ JPH::ShapeRefC JoltShapedObjectImpl3D::try_build_shape() {
 		}
 	}
 
+	mutable_compound_shape = nullptr;
+	mutable_sub_shape_indices.clear();
+
 	QUIET_FAIL_COND_D(built_shapes == 0);
 
 	JPH::ShapeRefC result = built_shapes == 1
@@ -147,24 +151,31 @@ JPH::ShapeRefC JoltShapedObjectImpl3D::try_build_shape() {
 
 	QUIET_FAIL_NULL_D(result);
 
+	Vector3 center_of_mass_offset;
+
 	if (has_custom_center_of_mass()) {
-		result = JoltShapeImpl3D::with_center_of_mass(result, get_center_of_mass_custom());
+		center_of_mass_offset = get_center_of_mass_custom() - to_godot(result->GetCenterOfMass());
 	}
 
-	if (scale != Vector3(1, 1, 1)) {
-		Vector3 actual_scale = scale;
+	Vector3 actual_scale = scale;
 
+	if (actual_scale != Vector3(1, 1, 1)) {
 		ENSURE_SCALE_VALID(
 			result,
 			actual_scale,
 			vformat("Failed to correctly scale body '%s'.", to_string())
 		);
-
-		result = JoltShapeImpl3D::with_scale(result, actual_scale);
 	}
 
-	if (is_area()) {
-		result = JoltShapeImpl3D::with_double_sided(result, true);
+	// The center-of-mass offset, scale and double-sidedness all go into a single decorator shape,
+	// rather than one decorator shape each, to keep the number of indirections down.
+	if (center_of_mass_offset != Vector3() || actual_scale != Vector3(1, 1, 1) || is_area()) {
+		result = JoltShapeImpl3D::with_decorations(
+			result,
+			actual_scale,
+			center_of_mass_offset,
+			is_area()
+		);
 	}
 
 	return result;
@@ -202,6 +213,8 @@ void JoltShapedObjectImpl3D::update_shape() {
 
 	space->get_body_iface().SetShape(jolt_id, jolt_shape, false, JPH::EActivation::DontActivate);
 
+	shape_revision += 1;
+
 	_shapes_built();
 }
 
@@ -254,7 +267,7 @@ void JoltShapedObjectImpl3D::set_shape(int32_t p_index, JoltShapeImpl3D* p_shape
 
 	shapes[p_index] = JoltShapeInstance3D(this, p_shape);
 
-	_shapes_changed();
+	_sub_shape_changed(p_index);
 }
 
 void JoltShapedObjectImpl3D::clear_shapes() {
@@ -327,7 +340,7 @@ void JoltShapedObjectImpl3D::set_shape_transform(int32_t p_index, Transform3D p_
 	shape.set_transform(p_transform);
 	shape.set_scale(new_scale);
 
-	_shapes_changed();
+	_sub_shape_changed(p_index);
 }
 
 bool JoltShapedObjectImpl3D::is_shape_disabled(int32_t p_index) const {
@@ -351,7 +364,7 @@ void JoltShapedObjectImpl3D::set_shape_disabled(int32_t p_index, bool p_disabled
 		shape.enable();
 	}
 
-	_shapes_changed();
+	_sub_shape_changed(p_index);
 }
 
 void JoltShapedObjectImpl3D::post_step(float p_step, JPH::Body& p_jolt_body) {
@@ -366,34 +379,50 @@ bool JoltShapedObjectImpl3D::_is_big() const {
 	return get_aabb().get_longest_axis_size() >= 1000.0f;
 }
 
-JPH::ShapeRefC JoltShapedObjectImpl3D::_try_build_single_shape() {
-	// NOLINTNEXTLINE(modernize-loop-convert)
-	for (int32_t shape_index = 0; shape_index < shapes.size(); ++shape_index) {
-		const JoltShapeInstance3D& sub_shape = shapes[shape_index];
+JPH::ShapeRefC JoltShapedObjectImpl3D::_try_build_sub_shape(int32_t p_index) const {
+	const JoltShapeInstance3D& sub_shape = shapes[p_index];
 
-		if (!sub_shape.is_enabled() || !sub_shape.is_built()) {
-			continue;
-		}
+	if (!sub_shape.is_enabled() || !sub_shape.is_built()) {
+		return {};
+	}
 
-		JPH::ShapeRefC jolt_sub_shape = sub_shape.get_jolt_ref();
+	Vector3 sub_shape_scale = sub_shape.get_scale();
 
-		Vector3 sub_shape_scale = sub_shape.get_scale();
-		const Transform3D sub_shape_transform = sub_shape.get_transform_unscaled();
+	if (sub_shape_scale == Vector3(1, 1, 1)) {
+		return sub_shape.get_jolt_ref();
+	}
 
-		if (sub_shape_scale != Vector3(1, 1, 1)) {
-			ENSURE_SCALE_VALID(
-				jolt_sub_shape,
-				sub_shape_scale,
-				vformat(
-					"Failed to correctly scale shape at index %d in body '%s'.",
-					shape_index,
-					to_string()
-				)
-			);
+	const JPH::Shape* jolt_inner_shape = sub_shape.get_jolt_inner_ref();
+
+	ENSURE_SCALE_VALID(
+		jolt_inner_shape,
+		sub_shape_scale,
+		vformat(
+			"Failed to correctly scale shape at index %d in body '%s'.",
+			p_index,
+			to_string()
+		)
+	);
 
-			jolt_sub_shape = JoltShapeImpl3D::with_scale(jolt_sub_shape, sub_shape_scale);
+	// Rather than scaling the shape instance as is, which would put a scaled shape on top of its
+	// user data shape, we give it a single decorator shape that does both.
+	return JoltShapeImpl3D::with_user_data_and_scale(
+		jolt_inner_shape,
+		(uint64_t)sub_shape.get_id(),
+		sub_shape_scale
+	);
+}
+
+JPH::ShapeRefC JoltShapedObjectImpl3D::_try_build_single_shape() {
+	for (int32_t shape_index = 0; shape_index < shapes.size(); ++shape_index) {
+		JPH::ShapeRefC jolt_sub_shape = _try_build_sub_shape(shape_index);
+
+		if (jolt_sub_shape == nullptr) {
+			continue;
 		}
 
+		const Transform3D sub_shape_transform = shapes[shape_index].get_transform_unscaled();
+
 		if (sub_shape_transform != Transform3D()) {
 			jolt_sub_shape = JoltShapeImpl3D::with_basis_origin(
 				jolt_sub_shape,
@@ -409,35 +438,63 @@ JPH::ShapeRefC JoltShapedObjectImpl3D::_try_build_single_shape() {
 }
 
 JPH::ShapeRefC JoltShapedObjectImpl3D::_try_build_compound_shape() {
+	if (use_mutable_compound) {
+		return _try_build_mutable_compound_shape();
+	}
+
 	JPH::StaticCompoundShapeSettings compound_shape_settings;
 
-	// NOLINTNEXTLINE(modernize-loop-convert)
 	for (int32_t shape_index = 0; shape_index < shapes.size(); ++shape_index) {
-		const JoltShapeInstance3D& sub_shape = shapes[shape_index];
+		const JPH::ShapeRefC jolt_sub_shape = _try_build_sub_shape(shape_index);
 
-		if (!sub_shape.is_enabled() || !sub_shape.is_built()) {
+		if (jolt_sub_shape == nullptr) {
 			continue;
 		}
 
-		JPH::ShapeRefC jolt_sub_shape = sub_shape.get_jolt_ref();
+		const Transform3D sub_shape_transform = shapes[shape_index].get_transform_unscaled();
 
-		Vector3 sub_shape_scale = sub_shape.get_scale();
-		const Transform3D sub_shape_transform = sub_shape.get_transform_unscaled();
+		compound_shape_settings.AddShape(
+			to_jolt(sub_shape_transform.origin),
+			to_jolt(sub_shape_transform.basis),
+			jolt_sub_shape
+		);
+	}
 
-		if (sub_shape_scale != Vector3(1, 1, 1)) {
-			ENSURE_SCALE_VALID(
-				jolt_sub_shape,
-				sub_shape_scale,
-				vformat(
-					"Failed to correctly scale shape at index %d in body '%s'.",
-					shape_index,
-					to_string()
-				)
-			);
+	const JPH::ShapeSettings::ShapeResult shape_result = compound_shape_settings.Create();
+
+	ERR_FAIL_COND_D_MSG(
+		shape_result.HasError(),
+		vformat(
+			"Failed to create compound shape with sub-shape count '%d'. "
+			"It returned the following error: '%s'.",
+			(int32_t)compound_shape_settings.mSubShapes.size(),
+			to_godot(shape_result.GetError())
+		)
+	);
+
+	return shape_result.Get();
+}
+
+JPH::ShapeRefC JoltShapedObjectImpl3D::_try_build_mutable_compound_shape() {
+	JPH::MutableCompoundShapeSettings compound_shape_settings;
 
-			jolt_sub_shape = JoltShapeImpl3D::with_scale(jolt_sub_shape, sub_shape_scale);
+	// Disabled (or broken) shapes are left out of the compound shape entirely, since any kind of
+	// placeholder would still contribute to its mass properties and bounds, so we keep track of
+	// which sub-shape every shape ended up as, which is what allows us to modify them later on.
+	mutable_sub_shape_indices.resize(shapes.size());
+
+	for (int32_t shape_index = 0; shape_index < shapes.size(); ++shape_index) {
+		const JPH::ShapeRefC jolt_sub_shape = _try_build_sub_shape(shape_index);
+
+		if (jolt_sub_shape == nullptr) {
+			mutable_sub_shape_indices[shape_index] = -1;
+			continue;
 		}
 
+		mutable_sub_shape_indices[shape_index] = (int32_t)compound_shape_settings.mSubShapes.size();
+
+		const Transform3D sub_shape_transform = shapes[shape_index].get_transform_unscaled();
+
 		compound_shape_settings.AddShape(
 			to_jolt(sub_shape_transform.origin),
 			to_jolt(sub_shape_transform.basis),
@@ -450,21 +507,126 @@ JPH::ShapeRefC JoltShapedObjectImpl3D::_try_build_compound_shape() {
 	ERR_FAIL_COND_D_MSG(
 		shape_result.HasError(),
 		vformat(
-			"Failed to create compound shape with sub-shape count '%d'. "
+			"Failed to create mutable compound shape with sub-shape count '%d'. "
 			"It returned the following error: '%s'.",
 			(int32_t)compound_shape_settings.mSubShapes.size(),
 			to_godot(shape_result.GetError())
 		)
 	);
 
+	mutable_compound_shape = static_cast<JPH::MutableCompoundShape*>(shape_result.Get().GetPtr());
+
 	return shape_result.Get();
 }
 
+bool JoltShapedObjectImpl3D::_try_modify_compound_shape(int32_t p_index) {
+	if (mutable_compound_shape == nullptr || !in_space()) {
+		return false;
+	}
+
+	ERR_FAIL_INDEX_D(p_index, mutable_sub_shape_indices.size());
+
+	JoltShapeInstance3D& sub_shape = shapes[p_index];
+
+	if (sub_shape.is_enabled()) {
+		sub_shape.try_build();
+	}
+
+	const JPH::ShapeRefC jolt_sub_shape = _try_build_sub_shape(p_index);
+	const int32_t sub_shape_index = mutable_sub_shape_indices[p_index];
+
+	// Adding or removing a sub-shape would shift the sub-shape IDs of every sub-shape after it,
+	// which contacts and area overlaps rely on staying the same, so we leave any shape being
+	// enabled or disabled to the regular rebuild instead.
+	if ((jolt_sub_shape == nullptr) != (sub_shape_index == -1)) {
+		return false;
+	}
+
+	// The shape isn't part of the compound shape, before or after, so there's nothing to modify.
+	if (jolt_sub_shape == nullptr) {
+		return true;
+	}
+
+	const JoltWritableBody3D body = space->write_body(jolt_id);
+	ERR_FAIL_COND_D(body.is_invalid());
+
+	const JPH::Vec3 previous_center_of_mass = jolt_shape->GetCenterOfMass();
+	const Transform3D sub_shape_transform = sub_shape.get_transform_unscaled();
+
+	mutable_compound_shape->ModifyShape(
+		(JPH::uint)sub_shape_index,
+		to_jolt(sub_shape_transform.origin),
+		to_jolt(sub_shape_transform.basis),
+		jolt_sub_shape
+	);
+
+	// A custom center-of-mass is applied as an offset relative to the center-of-mass of the
+	// compound shape at the time of building, so we can't move it without also moving that.
+	if (!has_custom_center_of_mass()) {
+		mutable_compound_shape->AdjustCenterOfMass();
+	}
+
+	space->get_body_iface().NotifyShapeChanged(
+		jolt_id,
+		previous_center_of_mass,
+		false,
+		JPH::EActivation::DontActivate
+	);
+
+	shape_revision += 1;
+
+	_shapes_built();
+
+	return true;
+}
+
+void JoltShapedObjectImpl3D::_sub_shape_changed(int32_t p_index) {
+	if (_try_modify_compound_shape(p_index)) {
+		_update_object_layer();
+		return;
+	}
+
+	const int32_t rebuild_threshold = JoltProjectSettings::get_mutable_compound_threshold();
+
+	// Objects whose individual shapes keep changing are switched over to a mutable compound shape,
+	// which can then be modified in place rather than rebuilt from scratch every time.
+	if (rebuild_threshold > 0 && !use_mutable_compound && shapes.size() > 1) {
+		compound_rebuild_count += 1;
+		use_mutable_compound = compound_rebuild_count >= rebuild_threshold;
+	}
+
+	_shapes_changed();
+}
+
 void JoltShapedObjectImpl3D::_shapes_changed() {
 	update_shape();
 	_update_object_layer();
 }
 
+void JoltShapedObjectImpl3D::_shape_modified_in_place() {
+	// Compound shapes keep track of the bounds of their sub-shapes, so those we have to rebuild.
+	if (!in_space() || jolt_shape->GetType() == JPH::EShapeType::Compound) {
+		_shapes_changed();
+		return;
+	}
+
+	const JoltWritableBody3D body = space->write_body(jolt_id);
+	ERR_FAIL_COND(body.is_invalid());
+
+	space->get_body_iface().NotifyShapeChanged(
+		jolt_id,
+		jolt_shape->GetCenterOfMass(),
+		false,
+		JPH::EActivation::DontActivate
+	);
+
+	space->invalidate_query_cache();
+
+	shape_revision += 1;
+
+	_shapes_built();
+}
+
 void JoltShapedObjectImpl3D::_space_changing() {
 	JoltObjectImpl3D::_space_changing();
 
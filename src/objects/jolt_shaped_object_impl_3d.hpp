@@ -44,6 +44,8 @@ public:
 
 	const JPH::Shape* get_previous_jolt_shape() const { return previous_jolt_shape; }
 
+	uint32_t get_shape_revision() const { return shape_revision; }
+
 	void add_shape(JoltShapeImpl3D* p_shape, Transform3D p_transform, bool p_disabled);
 
 	void remove_shape(const JoltShapeImpl3D* p_shape);
@@ -87,12 +89,22 @@ protected:
 
 	bool _is_big() const;
 
+	JPH::ShapeRefC _try_build_sub_shape(int32_t p_index) const;
+
 	JPH::ShapeRefC _try_build_single_shape();
 
 	JPH::ShapeRefC _try_build_compound_shape();
 
+	JPH::ShapeRefC _try_build_mutable_compound_shape();
+
+	bool _try_modify_compound_shape(int32_t p_index);
+
+	void _sub_shape_changed(int32_t p_index);
+
 	virtual void _shapes_changed();
 
+	void _shape_modified_in_place();
+
 	virtual void _shapes_built() { }
 
 	void _space_changing() override;
@@ -103,5 +115,15 @@ protected:
 
 	JPH::ShapeRefC previous_jolt_shape;
 
+	JPH::Ref<JPH::MutableCompoundShape> mutable_compound_shape;
+
+	LocalVector<int32_t> mutable_sub_shape_indices;
+
 	JPH::BodyCreationSettings* jolt_settings = new JPH::BodyCreationSettings();
+
+	uint32_t shape_revision = 0;
+
+	int32_t compound_rebuild_count = 0;
+
+	bool use_mutable_compound = false;
 };
@@ -306,6 +306,8 @@ void JoltSoftBodyImpl3D::set_transform(const Transform3D& p_transform) {
 		vertex.mVelocity = JPH::Vec3::sZero();
 	}
 
+	space->invalidate_query_cache();
+
 	_transform_changed();
 }
 
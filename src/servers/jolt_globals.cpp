@@ -2,6 +2,7 @@
 
 #include "objects/jolt_group_filter.hpp"
 #include "shapes/jolt_custom_double_sided_shape.hpp"
+#include "shapes/jolt_custom_fused_shape.hpp"
 #include "shapes/jolt_custom_ray_shape.hpp"
 #include "shapes/jolt_custom_user_data_shape.hpp"
 
@@ -88,6 +89,7 @@ void jolt_initialize() {
 	JoltCustomRayShape::register_type();
 	JoltCustomUserDataShape::register_type();
 	JoltCustomDoubleSidedShape::register_type();
+	JoltCustomFusedShape::register_type();
 
 	JoltGroupFilter::instance = new JoltGroupFilter();
 	JoltGroupFilter::instance->SetEmbedded();
@@ -8,6 +8,7 @@
 #include "joints/jolt_slider_joint_impl_3d.hpp"
 #include "objects/jolt_area_impl_3d.hpp"
 #include "objects/jolt_body_impl_3d.hpp"
+#include "objects/jolt_character_impl_3d.hpp"
 #include "objects/jolt_soft_body_impl_3d.hpp"
 #include "shapes/jolt_box_shape_impl_3d.hpp"
 #include "shapes/jolt_capsule_shape_impl_3d.hpp"
@@ -16,10 +17,13 @@
 #include "shapes/jolt_cylinder_shape_impl_3d.hpp"
 #include "shapes/jolt_height_map_shape_impl_3d.hpp"
 #include "shapes/jolt_separation_ray_shape_impl_3d.hpp"
+#include "shapes/jolt_shape_interner.hpp"
 #include "shapes/jolt_sphere_shape_impl_3d.hpp"
 #include "shapes/jolt_world_boundary_shape_impl_3d.hpp"
 #include "spaces/jolt_job_system.hpp"
 #include "spaces/jolt_physics_direct_space_state_3d.hpp"
+#include "spaces/jolt_projectile_pool_impl_3d.hpp"
+#include "spaces/jolt_query_impl_3d.hpp"
 #include "spaces/jolt_space_3d.hpp"
 
 namespace {
@@ -39,6 +43,93 @@ void JoltPhysicsServer3DExtension::_bind_methods() {
 	BIND_METHOD(JoltPhysicsServer3DExtension, space_dump_debug_snapshot, "space", "dir");
 #endif // GDJ_CONFIG_EDITOR
 
+	BIND_METHOD(JoltPhysicsServer3DExtension, shape_get_jolt_memory_usage, "shape");
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, heightmap_shape_update_region, "shape", "region", "heights");
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, area_get_jolt_param, "area", "param");
+	BIND_METHOD(JoltPhysicsServer3DExtension, area_set_jolt_param, "area", "param", "value");
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, area_get_jolt_flag, "area", "flag");
+	BIND_METHOD(JoltPhysicsServer3DExtension, area_set_jolt_flag, "area", "flag", "value");
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, body_test_motions, "bodies", "from", "motions", "margin", "max_collisions", "collide_separation_ray", "recovery_as_collision");
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, character_create);
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, character_get_space, "character");
+	BIND_METHOD(JoltPhysicsServer3DExtension, character_set_space, "character", "space");
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, character_get_shape, "character");
+	BIND_METHOD(JoltPhysicsServer3DExtension, character_set_shape, "character", "shape");
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, character_get_transform, "character");
+	BIND_METHOD(JoltPhysicsServer3DExtension, character_set_transform, "character", "transform");
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, character_get_velocity, "character");
+	BIND_METHOD(JoltPhysicsServer3DExtension, character_set_velocity, "character", "velocity");
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, character_get_collision_layer, "character");
+	BIND_METHOD(JoltPhysicsServer3DExtension, character_set_collision_layer, "character", "layer");
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, character_get_collision_mask, "character");
+	BIND_METHOD(JoltPhysicsServer3DExtension, character_set_collision_mask, "character", "mask");
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, character_get_jolt_param, "character", "param");
+	BIND_METHOD(JoltPhysicsServer3DExtension, character_set_jolt_param, "character", "param", "value");
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, character_get_ground_state, "character");
+	BIND_METHOD(JoltPhysicsServer3DExtension, character_get_ground_normal, "character");
+	BIND_METHOD(JoltPhysicsServer3DExtension, character_get_ground_velocity, "character");
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, query_create, "type");
+	BIND_METHOD(JoltPhysicsServer3DExtension, query_get_type, "query");
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, query_get_space, "query");
+	BIND_METHOD(JoltPhysicsServer3DExtension, query_set_space, "query", "space");
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, query_get_shape, "query");
+	BIND_METHOD(JoltPhysicsServer3DExtension, query_set_shape, "query", "shape");
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, query_get_transform, "query");
+	BIND_METHOD(JoltPhysicsServer3DExtension, query_set_transform, "query", "transform");
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, query_get_target_position, "query");
+	BIND_METHOD(JoltPhysicsServer3DExtension, query_set_target_position, "query", "position");
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, query_get_margin, "query");
+	BIND_METHOD(JoltPhysicsServer3DExtension, query_set_margin, "query", "margin");
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, query_get_collision_mask, "query");
+	BIND_METHOD(JoltPhysicsServer3DExtension, query_set_collision_mask, "query", "mask");
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, query_get_jolt_flag, "query", "flag");
+	BIND_METHOD(JoltPhysicsServer3DExtension, query_set_jolt_flag, "query", "flag", "enabled");
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, query_add_exception, "query", "object");
+	BIND_METHOD(JoltPhysicsServer3DExtension, query_remove_exception, "query", "object");
+	BIND_METHOD(JoltPhysicsServer3DExtension, query_clear_exceptions, "query");
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, query_is_colliding, "query");
+	BIND_METHOD(JoltPhysicsServer3DExtension, query_get_result, "query");
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, projectile_pool_create);
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, projectile_pool_get_space, "pool");
+	BIND_METHOD(JoltPhysicsServer3DExtension, projectile_pool_set_space, "pool", "space");
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, projectile_pool_get_collision_mask, "pool");
+	BIND_METHOD(JoltPhysicsServer3DExtension, projectile_pool_set_collision_mask, "pool", "mask");
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, projectile_pool_get_jolt_param, "pool", "param");
+	BIND_METHOD(JoltPhysicsServer3DExtension, projectile_pool_set_jolt_param, "pool", "param", "value");
+
+	BIND_METHOD(JoltPhysicsServer3DExtension, projectile_pool_spawn, "pool", "position", "velocity");
+	BIND_METHOD(JoltPhysicsServer3DExtension, projectile_pool_clear, "pool");
+	BIND_METHOD(JoltPhysicsServer3DExtension, projectile_pool_get_count, "pool");
+	BIND_METHOD(JoltPhysicsServer3DExtension, projectile_pool_get_positions, "pool");
+	BIND_METHOD(JoltPhysicsServer3DExtension, projectile_pool_get_impacts, "pool");
+
 	BIND_METHOD(JoltPhysicsServer3DExtension, joint_get_enabled, "joint");
 	BIND_METHOD(JoltPhysicsServer3DExtension, joint_set_enabled, "joint", "enabled");
 
@@ -88,6 +179,39 @@ void JoltPhysicsServer3DExtension::_bind_methods() {
 
 	// clang-format on
 
+	BIND_ENUM_CONSTANT(AREA_BUOYANCY_SURFACE);
+	BIND_ENUM_CONSTANT(AREA_BUOYANCY_FLUID_DENSITY);
+	BIND_ENUM_CONSTANT(AREA_BUOYANCY_LINEAR_DRAG);
+	BIND_ENUM_CONSTANT(AREA_BUOYANCY_ANGULAR_DRAG);
+
+	BIND_ENUM_CONSTANT(AREA_FLAG_ENABLE_BUOYANCY);
+
+	BIND_ENUM_CONSTANT(CHARACTER_MAX_SLOPE_ANGLE);
+	BIND_ENUM_CONSTANT(CHARACTER_STEP_HEIGHT);
+	BIND_ENUM_CONSTANT(CHARACTER_FLOOR_SNAP_LENGTH);
+	BIND_ENUM_CONSTANT(CHARACTER_MASS);
+	BIND_ENUM_CONSTANT(CHARACTER_MAX_PUSH_FORCE);
+	BIND_ENUM_CONSTANT(CHARACTER_SAFE_MARGIN);
+
+	BIND_ENUM_CONSTANT(CHARACTER_GROUND_STATE_ON_FLOOR);
+	BIND_ENUM_CONSTANT(CHARACTER_GROUND_STATE_ON_STEEP_GROUND);
+	BIND_ENUM_CONSTANT(CHARACTER_GROUND_STATE_NOT_SUPPORTED);
+	BIND_ENUM_CONSTANT(CHARACTER_GROUND_STATE_IN_AIR);
+
+	BIND_ENUM_CONSTANT(PROJECTILE_POOL_GRAVITY_SCALE);
+	BIND_ENUM_CONSTANT(PROJECTILE_POOL_LINEAR_DRAG);
+	BIND_ENUM_CONSTANT(PROJECTILE_POOL_MASS);
+	BIND_ENUM_CONSTANT(PROJECTILE_POOL_LIFETIME);
+
+	BIND_ENUM_CONSTANT(QUERY_TYPE_RAY);
+	BIND_ENUM_CONSTANT(QUERY_TYPE_SHAPE_CAST);
+
+	BIND_ENUM_CONSTANT(QUERY_FLAG_ENABLED);
+	BIND_ENUM_CONSTANT(QUERY_FLAG_COLLIDE_WITH_BODIES);
+	BIND_ENUM_CONSTANT(QUERY_FLAG_COLLIDE_WITH_AREAS);
+	BIND_ENUM_CONSTANT(QUERY_FLAG_HIT_FROM_INSIDE);
+	BIND_ENUM_CONSTANT(QUERY_FLAG_HIT_BACK_FACES);
+
 	BIND_ENUM_CONSTANT(HINGE_JOINT_LIMIT_SPRING_FREQUENCY);
 	BIND_ENUM_CONSTANT(HINGE_JOINT_LIMIT_SPRING_DAMPING);
 	BIND_ENUM_CONSTANT(HINGE_JOINT_MOTOR_MAX_TORQUE);
@@ -219,6 +343,9 @@ void JoltPhysicsServer3DExtension::_shape_set_data(const RID& p_shape, const Var
 	JoltShapeImpl3D* shape = shape_owner.get_or_null(p_shape);
 	ERR_FAIL_NULL(shape);
 
+	// Any background cooking of this shape reads the data we're about to change, so we wait for it.
+	shape->cancel_cooking();
+
 	shape->set_data(p_data);
 }
 
@@ -250,6 +377,8 @@ void JoltPhysicsServer3DExtension::_shape_set_margin(const RID& p_shape, real_t
 	JoltShapeImpl3D* shape = shape_owner.get_or_null(p_shape);
 	ERR_FAIL_NULL(shape);
 
+	shape->cancel_cooking();
+
 	shape->set_margin((float)p_margin);
 }
 
@@ -2045,6 +2174,12 @@ void JoltPhysicsServer3DExtension::_free_rid(const RID& p_rid) {
 		free_area(area);
 	} else if (JoltSoftBodyImpl3D* soft_body = soft_body_owner.get_or_null(p_rid)) {
 		free_soft_body(soft_body);
+	} else if (JoltCharacterImpl3D* character = character_owner.get_or_null(p_rid)) {
+		free_character(character);
+	} else if (JoltQueryImpl3D* query = query_owner.get_or_null(p_rid)) {
+		free_query(query);
+	} else if (JoltProjectilePoolImpl3D* pool = projectile_pool_owner.get_or_null(p_rid)) {
+		free_projectile_pool(pool);
 	} else if (JoltSpace3D* space = space_owner.get_or_null(p_rid)) {
 		free_space(space);
 	} else {
@@ -2065,6 +2200,9 @@ void JoltPhysicsServer3DExtension::_step(real_t p_step) {
 		return;
 	}
 
+	JoltShapeImpl3D::finish_cooked_shapes();
+	JoltShapeInterner::prune();
+
 	for (JoltSpace3D* active_space : active_spaces) {
 		job_system->pre_step();
 
@@ -2093,6 +2231,8 @@ void JoltPhysicsServer3DExtension::_flush_queries() {
 }
 
 void JoltPhysicsServer3DExtension::_finish() {
+	JoltShapeInterner::clear();
+
 	delete_safely(job_system);
 }
 
@@ -2139,9 +2279,35 @@ void JoltPhysicsServer3DExtension::free_soft_body(JoltSoftBodyImpl3D* p_body) {
 	memdelete_safely(p_body);
 }
 
+void JoltPhysicsServer3DExtension::free_character(JoltCharacterImpl3D* p_character) {
+	ERR_FAIL_NULL(p_character);
+
+	p_character->set_space(nullptr);
+	character_owner.free(p_character->get_rid());
+	memdelete_safely(p_character);
+}
+
+void JoltPhysicsServer3DExtension::free_query(JoltQueryImpl3D* p_query) {
+	ERR_FAIL_NULL(p_query);
+
+	p_query->set_space(nullptr);
+	query_owner.free(p_query->get_rid());
+	memdelete_safely(p_query);
+}
+
+void JoltPhysicsServer3DExtension::free_projectile_pool(JoltProjectilePoolImpl3D* p_pool) {
+	ERR_FAIL_NULL(p_pool);
+
+	p_pool->set_space(nullptr);
+	projectile_pool_owner.free(p_pool->get_rid());
+	memdelete_safely(p_pool);
+}
+
 void JoltPhysicsServer3DExtension::free_shape(JoltShapeImpl3D* p_shape) {
 	ERR_FAIL_NULL(p_shape);
 
+	// Any background cooking reads data that's about to be freed, so we wait for it.
+	p_shape->cancel_cooking();
 	p_shape->remove_self();
 	shape_owner.free(p_shape->get_rid());
 	memdelete_safely(p_shape);
@@ -2174,6 +2340,604 @@ void JoltPhysicsServer3DExtension::space_dump_debug_snapshot(
 
 #endif // GDJ_CONFIG_EDITOR
 
+int64_t JoltPhysicsServer3DExtension::shape_get_jolt_memory_usage(const RID& p_shape) {
+	JoltShapeImpl3D* shape = shape_owner.get_or_null(p_shape);
+	ERR_FAIL_NULL_D(shape);
+
+	const JPH::ShapeRefC jolt_shape = shape->try_build();
+	QUIET_FAIL_NULL_D(jolt_shape);
+
+	JPH::Shape::VisitedShapes visited_shapes;
+	return (int64_t)jolt_shape->GetStatsRecursive(visited_shapes).mSizeBytes;
+}
+
+void JoltPhysicsServer3DExtension::heightmap_shape_update_region(
+	const RID& p_shape,
+	const Rect2i& p_region,
+	const PackedFloat32Array& p_heights
+) {
+	JoltShapeImpl3D* shape = shape_owner.get_or_null(p_shape);
+	ERR_FAIL_NULL(shape);
+
+	ERR_FAIL_COND_MSG(
+		shape->get_type() != SHAPE_HEIGHTMAP,
+		vformat(
+			"Failed to update region of shape with RID '%d'. It's not a height map shape.",
+			p_shape.get_id()
+		)
+	);
+
+	static_cast<JoltHeightMapShapeImpl3D*>(shape)->update_region(p_region, p_heights);
+}
+
+Variant JoltPhysicsServer3DExtension::area_get_jolt_param(
+	const RID& p_area,
+	AreaParamJolt p_param
+) const {
+	const JoltAreaImpl3D* area = area_owner.get_or_null(p_area);
+	ERR_FAIL_NULL_D(area);
+
+	return area->get_jolt_param(p_param);
+}
+
+void JoltPhysicsServer3DExtension::area_set_jolt_param(
+	const RID& p_area,
+	AreaParamJolt p_param,
+	const Variant& p_value
+) {
+	JoltAreaImpl3D* area = area_owner.get_or_null(p_area);
+	ERR_FAIL_NULL(area);
+
+	area->set_jolt_param(p_param, p_value);
+}
+
+bool JoltPhysicsServer3DExtension::area_get_jolt_flag(
+	const RID& p_area,
+	AreaFlagJolt p_flag
+) const {
+	const JoltAreaImpl3D* area = area_owner.get_or_null(p_area);
+	ERR_FAIL_NULL_D(area);
+
+	return area->get_jolt_flag(p_flag);
+}
+
+void JoltPhysicsServer3DExtension::area_set_jolt_flag(
+	const RID& p_area,
+	AreaFlagJolt p_flag,
+	bool p_enabled
+) {
+	JoltAreaImpl3D* area = area_owner.get_or_null(p_area);
+	ERR_FAIL_NULL(area);
+
+	area->set_jolt_flag(p_flag, p_enabled);
+}
+
+Dictionary JoltPhysicsServer3DExtension::body_test_motions(
+	const TypedArray<RID>& p_bodies,
+	const TypedArray<Transform3D>& p_from,
+	const PackedVector3Array& p_motions,
+	real_t p_margin,
+	int32_t p_max_collisions,
+	bool p_collide_separation_ray,
+	bool p_recovery_as_collision
+) const {
+	const auto body_count = (int32_t)p_bodies.size();
+
+	LocalVector<const JoltBodyImpl3D*> bodies;
+	bodies.resize(body_count);
+
+	JoltSpace3D* space = nullptr;
+
+	for (int32_t i = 0; i < body_count; ++i) {
+		const JoltBodyImpl3D* body = body_owner.get_or_null(p_bodies[i]);
+		ERR_FAIL_NULL_D(body);
+
+		JoltSpace3D* body_space = body->get_space();
+		ERR_FAIL_NULL_D(body_space);
+
+		ERR_FAIL_COND_D_MSG(
+			space != nullptr && body_space != space,
+			vformat(
+				"Failed to test body motions. "
+				"All bodies must be in the same physics space, but '%s' was not.",
+				body->to_string()
+			)
+		);
+
+		space = body_space;
+		bodies[i] = body;
+	}
+
+	if (space == nullptr) {
+		return {};
+	}
+
+	return space->get_direct_state()->test_body_motions(
+		bodies.ptr(),
+		body_count,
+		p_from,
+		p_motions,
+		(float)p_margin,
+		p_max_collisions,
+		p_collide_separation_ray,
+		p_recovery_as_collision
+	);
+}
+
+RID JoltPhysicsServer3DExtension::character_create() {
+	JoltCharacterImpl3D* character = memnew(JoltCharacterImpl3D);
+	RID rid = character_owner.make_rid(character);
+	character->set_rid(rid);
+	return rid;
+}
+
+RID JoltPhysicsServer3DExtension::character_get_space(const RID& p_character) const {
+	const JoltCharacterImpl3D* character = character_owner.get_or_null(p_character);
+	ERR_FAIL_NULL_D(character);
+
+	const JoltSpace3D* space = character->get_space();
+
+	if (space == nullptr) {
+		return {};
+	}
+
+	return space->get_rid();
+}
+
+void JoltPhysicsServer3DExtension::character_set_space(
+	const RID& p_character,
+	const RID& p_space
+) {
+	JoltCharacterImpl3D* character = character_owner.get_or_null(p_character);
+	ERR_FAIL_NULL(character);
+
+	JoltSpace3D* space = nullptr;
+
+	if (p_space.is_valid()) {
+		space = space_owner.get_or_null(p_space);
+		ERR_FAIL_NULL(space);
+	}
+
+	character->set_space(space);
+}
+
+RID JoltPhysicsServer3DExtension::character_get_shape(const RID& p_character) const {
+	const JoltCharacterImpl3D* character = character_owner.get_or_null(p_character);
+	ERR_FAIL_NULL_D(character);
+
+	return character->get_shape();
+}
+
+void JoltPhysicsServer3DExtension::character_set_shape(
+	const RID& p_character,
+	const RID& p_shape
+) {
+	JoltCharacterImpl3D* character = character_owner.get_or_null(p_character);
+	ERR_FAIL_NULL(character);
+
+	JoltShapeImpl3D* shape = nullptr;
+
+	if (p_shape.is_valid()) {
+		shape = shape_owner.get_or_null(p_shape);
+		ERR_FAIL_NULL(shape);
+	}
+
+	character->set_shape(shape);
+}
+
+Transform3D JoltPhysicsServer3DExtension::character_get_transform(const RID& p_character) const {
+	const JoltCharacterImpl3D* character = character_owner.get_or_null(p_character);
+	ERR_FAIL_NULL_D(character);
+
+	return character->get_transform();
+}
+
+void JoltPhysicsServer3DExtension::character_set_transform(
+	const RID& p_character,
+	const Transform3D& p_transform
+) {
+	JoltCharacterImpl3D* character = character_owner.get_or_null(p_character);
+	ERR_FAIL_NULL(character);
+
+	character->set_transform(p_transform);
+}
+
+Vector3 JoltPhysicsServer3DExtension::character_get_velocity(const RID& p_character) const {
+	const JoltCharacterImpl3D* character = character_owner.get_or_null(p_character);
+	ERR_FAIL_NULL_D(character);
+
+	return character->get_velocity();
+}
+
+void JoltPhysicsServer3DExtension::character_set_velocity(
+	const RID& p_character,
+	const Vector3& p_velocity
+) {
+	JoltCharacterImpl3D* character = character_owner.get_or_null(p_character);
+	ERR_FAIL_NULL(character);
+
+	character->set_velocity(p_velocity);
+}
+
+uint32_t JoltPhysicsServer3DExtension::character_get_collision_layer(
+	const RID& p_character
+) const {
+	const JoltCharacterImpl3D* character = character_owner.get_or_null(p_character);
+	ERR_FAIL_NULL_D(character);
+
+	return character->get_collision_layer();
+}
+
+void JoltPhysicsServer3DExtension::character_set_collision_layer(
+	const RID& p_character,
+	uint32_t p_layer
+) {
+	JoltCharacterImpl3D* character = character_owner.get_or_null(p_character);
+	ERR_FAIL_NULL(character);
+
+	character->set_collision_layer(p_layer);
+}
+
+uint32_t JoltPhysicsServer3DExtension::character_get_collision_mask(const RID& p_character) const {
+	const JoltCharacterImpl3D* character = character_owner.get_or_null(p_character);
+	ERR_FAIL_NULL_D(character);
+
+	return character->get_collision_mask();
+}
+
+void JoltPhysicsServer3DExtension::character_set_collision_mask(
+	const RID& p_character,
+	uint32_t p_mask
+) {
+	JoltCharacterImpl3D* character = character_owner.get_or_null(p_character);
+	ERR_FAIL_NULL(character);
+
+	character->set_collision_mask(p_mask);
+}
+
+double JoltPhysicsServer3DExtension::character_get_jolt_param(
+	const RID& p_character,
+	CharacterParamJolt p_param
+) const {
+	const JoltCharacterImpl3D* character = character_owner.get_or_null(p_character);
+	ERR_FAIL_NULL_D(character);
+
+	return character->get_jolt_param(p_param);
+}
+
+void JoltPhysicsServer3DExtension::character_set_jolt_param(
+	const RID& p_character,
+	CharacterParamJolt p_param,
+	double p_value
+) {
+	JoltCharacterImpl3D* character = character_owner.get_or_null(p_character);
+	ERR_FAIL_NULL(character);
+
+	character->set_jolt_param(p_param, p_value);
+}
+
+JoltPhysicsServer3DExtension::CharacterGroundStateJolt
+JoltPhysicsServer3DExtension::character_get_ground_state(const RID& p_character) const {
+	const JoltCharacterImpl3D* character = character_owner.get_or_null(p_character);
+	ERR_FAIL_NULL_D(character);
+
+	return character->get_ground_state();
+}
+
+Vector3 JoltPhysicsServer3DExtension::character_get_ground_normal(const RID& p_character) const {
+	const JoltCharacterImpl3D* character = character_owner.get_or_null(p_character);
+	ERR_FAIL_NULL_D(character);
+
+	return character->get_ground_normal();
+}
+
+Vector3 JoltPhysicsServer3DExtension::character_get_ground_velocity(const RID& p_character) const {
+	const JoltCharacterImpl3D* character = character_owner.get_or_null(p_character);
+	ERR_FAIL_NULL_D(character);
+
+	return character->get_ground_velocity();
+}
+
+RID JoltPhysicsServer3DExtension::query_create(QueryTypeJolt p_type) {
+	JoltQueryImpl3D* query = memnew(JoltQueryImpl3D(p_type));
+	RID rid = query_owner.make_rid(query);
+	query->set_rid(rid);
+	return rid;
+}
+
+JoltPhysicsServer3DExtension::QueryTypeJolt
+JoltPhysicsServer3DExtension::query_get_type(const RID& p_query) const {
+	const JoltQueryImpl3D* query = query_owner.get_or_null(p_query);
+	ERR_FAIL_NULL_D(query);
+
+	return query->get_type();
+}
+
+RID JoltPhysicsServer3DExtension::query_get_space(const RID& p_query) const {
+	const JoltQueryImpl3D* query = query_owner.get_or_null(p_query);
+	ERR_FAIL_NULL_D(query);
+
+	const JoltSpace3D* space = query->get_space();
+
+	if (space == nullptr) {
+		return {};
+	}
+
+	return space->get_rid();
+}
+
+void JoltPhysicsServer3DExtension::query_set_space(const RID& p_query, const RID& p_space) {
+	JoltQueryImpl3D* query = query_owner.get_or_null(p_query);
+	ERR_FAIL_NULL(query);
+
+	JoltSpace3D* space = nullptr;
+
+	if (p_space.is_valid()) {
+		space = space_owner.get_or_null(p_space);
+		ERR_FAIL_NULL(space);
+	}
+
+	query->set_space(space);
+}
+
+RID JoltPhysicsServer3DExtension::query_get_shape(const RID& p_query) const {
+	const JoltQueryImpl3D* query = query_owner.get_or_null(p_query);
+	ERR_FAIL_NULL_D(query);
+
+	return query->get_shape();
+}
+
+void JoltPhysicsServer3DExtension::query_set_shape(const RID& p_query, const RID& p_shape) {
+	JoltQueryImpl3D* query = query_owner.get_or_null(p_query);
+	ERR_FAIL_NULL(query);
+
+	JoltShapeImpl3D* shape = nullptr;
+
+	if (p_shape.is_valid()) {
+		shape = shape_owner.get_or_null(p_shape);
+		ERR_FAIL_NULL(shape);
+	}
+
+	query->set_shape(shape);
+}
+
+Transform3D JoltPhysicsServer3DExtension::query_get_transform(const RID& p_query) const {
+	const JoltQueryImpl3D* query = query_owner.get_or_null(p_query);
+	ERR_FAIL_NULL_D(query);
+
+	return query->get_transform();
+}
+
+void JoltPhysicsServer3DExtension::query_set_transform(
+	const RID& p_query,
+	const Transform3D& p_transform
+) {
+	JoltQueryImpl3D* query = query_owner.get_or_null(p_query);
+	ERR_FAIL_NULL(query);
+
+	query->set_transform(p_transform);
+}
+
+Vector3 JoltPhysicsServer3DExtension::query_get_target_position(const RID& p_query) const {
+	const JoltQueryImpl3D* query = query_owner.get_or_null(p_query);
+	ERR_FAIL_NULL_D(query);
+
+	return query->get_target_position();
+}
+
+void JoltPhysicsServer3DExtension::query_set_target_position(
+	const RID& p_query,
+	const Vector3& p_position
+) {
+	JoltQueryImpl3D* query = query_owner.get_or_null(p_query);
+	ERR_FAIL_NULL(query);
+
+	query->set_target_position(p_position);
+}
+
+float JoltPhysicsServer3DExtension::query_get_margin(const RID& p_query) const {
+	const JoltQueryImpl3D* query = query_owner.get_or_null(p_query);
+	ERR_FAIL_NULL_D(query);
+
+	return query->get_margin();
+}
+
+void JoltPhysicsServer3DExtension::query_set_margin(const RID& p_query, float p_margin) {
+	JoltQueryImpl3D* query = query_owner.get_or_null(p_query);
+	ERR_FAIL_NULL(query);
+
+	query->set_margin(p_margin);
+}
+
+uint32_t JoltPhysicsServer3DExtension::query_get_collision_mask(const RID& p_query) const {
+	const JoltQueryImpl3D* query = query_owner.get_or_null(p_query);
+	ERR_FAIL_NULL_D(query);
+
+	return query->get_collision_mask();
+}
+
+void JoltPhysicsServer3DExtension::query_set_collision_mask(const RID& p_query, uint32_t p_mask) {
+	JoltQueryImpl3D* query = query_owner.get_or_null(p_query);
+	ERR_FAIL_NULL(query);
+
+	query->set_collision_mask(p_mask);
+}
+
+bool JoltPhysicsServer3DExtension::query_get_jolt_flag(
+	const RID& p_query,
+	QueryFlagJolt p_flag
+) const {
+	const JoltQueryImpl3D* query = query_owner.get_or_null(p_query);
+	ERR_FAIL_NULL_D(query);
+
+	return query->get_jolt_flag(p_flag);
+}
+
+void JoltPhysicsServer3DExtension::query_set_jolt_flag(
+	const RID& p_query,
+	QueryFlagJolt p_flag,
+	bool p_enabled
+) {
+	JoltQueryImpl3D* query = query_owner.get_or_null(p_query);
+	ERR_FAIL_NULL(query);
+
+	query->set_jolt_flag(p_flag, p_enabled);
+}
+
+void JoltPhysicsServer3DExtension::query_add_exception(const RID& p_query, const RID& p_object) {
+	JoltQueryImpl3D* query = query_owner.get_or_null(p_query);
+	ERR_FAIL_NULL(query);
+
+	query->add_exception(p_object);
+}
+
+void JoltPhysicsServer3DExtension::query_remove_exception(
+	const RID& p_query,
+	const RID& p_object
+) {
+	JoltQueryImpl3D* query = query_owner.get_or_null(p_query);
+	ERR_FAIL_NULL(query);
+
+	query->remove_exception(p_object);
+}
+
+void JoltPhysicsServer3DExtension::query_clear_exceptions(const RID& p_query) {
+	JoltQueryImpl3D* query = query_owner.get_or_null(p_query);
+	ERR_FAIL_NULL(query);
+
+	query->clear_exceptions();
+}
+
+bool JoltPhysicsServer3DExtension::query_is_colliding(const RID& p_query) const {
+	const JoltQueryImpl3D* query = query_owner.get_or_null(p_query);
+	ERR_FAIL_NULL_D(query);
+
+	return query->is_colliding();
+}
+
+Dictionary JoltPhysicsServer3DExtension::query_get_result(const RID& p_query) const {
+	const JoltQueryImpl3D* query = query_owner.get_or_null(p_query);
+	ERR_FAIL_NULL_D(query);
+
+	return query->get_result();
+}
+
+RID JoltPhysicsServer3DExtension::projectile_pool_create() {
+	JoltProjectilePoolImpl3D* pool = memnew(JoltProjectilePoolImpl3D);
+	RID rid = projectile_pool_owner.make_rid(pool);
+	pool->set_rid(rid);
+	return rid;
+}
+
+RID JoltPhysicsServer3DExtension::projectile_pool_get_space(const RID& p_pool) const {
+	const JoltProjectilePoolImpl3D* pool = projectile_pool_owner.get_or_null(p_pool);
+	ERR_FAIL_NULL_D(pool);
+
+	const JoltSpace3D* space = pool->get_space();
+
+	if (space == nullptr) {
+		return {};
+	}
+
+	return space->get_rid();
+}
+
+void JoltPhysicsServer3DExtension::projectile_pool_set_space(
+	const RID& p_pool,
+	const RID& p_space
+) {
+	JoltProjectilePoolImpl3D* pool = projectile_pool_owner.get_or_null(p_pool);
+	ERR_FAIL_NULL(pool);
+
+	JoltSpace3D* space = nullptr;
+
+	if (p_space.is_valid()) {
+		space = space_owner.get_or_null(p_space);
+		ERR_FAIL_NULL(space);
+	}
+
+	pool->set_space(space);
+}
+
+uint32_t JoltPhysicsServer3DExtension::projectile_pool_get_collision_mask(const RID& p_pool) const {
+	const JoltProjectilePoolImpl3D* pool = projectile_pool_owner.get_or_null(p_pool);
+	ERR_FAIL_NULL_D(pool);
+
+	return pool->get_collision_mask();
+}
+
+void JoltPhysicsServer3DExtension::projectile_pool_set_collision_mask(
+	const RID& p_pool,
+	uint32_t p_mask
+) {
+	JoltProjectilePoolImpl3D* pool = projectile_pool_owner.get_or_null(p_pool);
+	ERR_FAIL_NULL(pool);
+
+	pool->set_collision_mask(p_mask);
+}
+
+double JoltPhysicsServer3DExtension::projectile_pool_get_jolt_param(
+	const RID& p_pool,
+	ProjectilePoolParamJolt p_param
+) const {
+	const JoltProjectilePoolImpl3D* pool = projectile_pool_owner.get_or_null(p_pool);
+	ERR_FAIL_NULL_D(pool);
+
+	return pool->get_jolt_param(p_param);
+}
+
+void JoltPhysicsServer3DExtension::projectile_pool_set_jolt_param(
+	const RID& p_pool,
+	ProjectilePoolParamJolt p_param,
+	double p_value
+) {
+	JoltProjectilePoolImpl3D* pool = projectile_pool_owner.get_or_null(p_pool);
+	ERR_FAIL_NULL(pool);
+
+	pool->set_jolt_param(p_param, p_value);
+}
+
+int64_t JoltPhysicsServer3DExtension::projectile_pool_spawn(
+	const RID& p_pool,
+	const Vector3& p_position,
+	const Vector3& p_velocity
+) {
+	JoltProjectilePoolImpl3D* pool = projectile_pool_owner.get_or_null(p_pool);
+	ERR_FAIL_NULL_D(pool);
+
+	return pool->spawn(p_position, p_velocity);
+}
+
+void JoltPhysicsServer3DExtension::projectile_pool_clear(const RID& p_pool) {
+	JoltProjectilePoolImpl3D* pool = projectile_pool_owner.get_or_null(p_pool);
+	ERR_FAIL_NULL(pool);
+
+	pool->clear();
+}
+
+int32_t JoltPhysicsServer3DExtension::projectile_pool_get_count(const RID& p_pool) const {
+	const JoltProjectilePoolImpl3D* pool = projectile_pool_owner.get_or_null(p_pool);
+	ERR_FAIL_NULL_D(pool);
+
+	return pool->get_count();
+}
+
+PackedVector3Array JoltPhysicsServer3DExtension::projectile_pool_get_positions(
+	const RID& p_pool
+) const {
+	const JoltProjectilePoolImpl3D* pool = projectile_pool_owner.get_or_null(p_pool);
+	ERR_FAIL_NULL_D(pool);
+
+	return pool->get_positions();
+}
+
+Dictionary JoltPhysicsServer3DExtension::projectile_pool_get_impacts(const RID& p_pool) const {
+	const JoltProjectilePoolImpl3D* pool = projectile_pool_owner.get_or_null(p_pool);
+	ERR_FAIL_NULL_D(pool);
+
+	return pool->get_impacts();
+}
+
 bool JoltPhysicsServer3DExtension::joint_get_enabled(const RID& p_joint) const {
 	JoltJointImpl3D* joint = joint_owner.get_or_null(p_joint);
 	ERR_FAIL_NULL_D(joint);
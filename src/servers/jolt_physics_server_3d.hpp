@@ -2,8 +2,11 @@
 
 class JoltAreaImpl3D;
 class JoltBodyImpl3D;
+class JoltCharacterImpl3D;
 class JoltJobSystem;
 class JoltJointImpl3D;
+class JoltProjectilePoolImpl3D;
+class JoltQueryImpl3D;
 class JoltShapeImpl3D;
 class JoltSoftBodyImpl3D;
 class JoltSpace3D;
@@ -12,6 +15,53 @@ class JoltPhysicsServer3DExtension final : public PhysicsServer3DExtension {
 	GDCLASS_QUIET(JoltPhysicsServer3DExtension, PhysicsServer3DExtension)
 
 public:
+	enum AreaParamJolt {
+		AREA_BUOYANCY_SURFACE = 100,
+		AREA_BUOYANCY_FLUID_DENSITY,
+		AREA_BUOYANCY_LINEAR_DRAG,
+		AREA_BUOYANCY_ANGULAR_DRAG
+	};
+
+	enum AreaFlagJolt {
+		AREA_FLAG_ENABLE_BUOYANCY = 100
+	};
+
+	enum CharacterParamJolt {
+		CHARACTER_MAX_SLOPE_ANGLE,
+		CHARACTER_STEP_HEIGHT,
+		CHARACTER_FLOOR_SNAP_LENGTH,
+		CHARACTER_MASS,
+		CHARACTER_MAX_PUSH_FORCE,
+		CHARACTER_SAFE_MARGIN
+	};
+
+	enum CharacterGroundStateJolt {
+		CHARACTER_GROUND_STATE_ON_FLOOR,
+		CHARACTER_GROUND_STATE_ON_STEEP_GROUND,
+		CHARACTER_GROUND_STATE_NOT_SUPPORTED,
+		CHARACTER_GROUND_STATE_IN_AIR
+	};
+
+	enum ProjectilePoolParamJolt {
+		PROJECTILE_POOL_GRAVITY_SCALE,
+		PROJECTILE_POOL_LINEAR_DRAG,
+		PROJECTILE_POOL_MASS,
+		PROJECTILE_POOL_LIFETIME
+	};
+
+	enum QueryTypeJolt {
+		QUERY_TYPE_RAY,
+		QUERY_TYPE_SHAPE_CAST
+	};
+
+	enum QueryFlagJolt {
+		QUERY_FLAG_ENABLED,
+		QUERY_FLAG_COLLIDE_WITH_BODIES,
+		QUERY_FLAG_COLLIDE_WITH_AREAS,
+		QUERY_FLAG_HIT_FROM_INSIDE,
+		QUERY_FLAG_HIT_BACK_FACES
+	};
+
 	enum HingeJointParamJolt {
 		HINGE_JOINT_LIMIT_SPRING_FREQUENCY = 100,
 		HINGE_JOINT_LIMIT_SPRING_DAMPING,
@@ -673,6 +723,12 @@ public:
 
 	void free_body(JoltBodyImpl3D* p_body);
 
+	void free_character(JoltCharacterImpl3D* p_character);
+
+	void free_query(JoltQueryImpl3D* p_query);
+
+	void free_projectile_pool(JoltProjectilePoolImpl3D* p_pool);
+
 	void free_soft_body(JoltSoftBodyImpl3D* p_body);
 
 	void free_shape(JoltShapeImpl3D* p_shape);
@@ -695,6 +751,146 @@ public:
 	void space_dump_debug_snapshot(const RID& p_space, const String& p_dir);
 #endif // GDJ_CONFIG_EDITOR
 
+	int64_t shape_get_jolt_memory_usage(const RID& p_shape);
+
+	void heightmap_shape_update_region(
+		const RID& p_shape,
+		const Rect2i& p_region,
+		const PackedFloat32Array& p_heights
+	);
+
+	Variant area_get_jolt_param(const RID& p_area, AreaParamJolt p_param) const;
+
+	void area_set_jolt_param(const RID& p_area, AreaParamJolt p_param, const Variant& p_value);
+
+	bool area_get_jolt_flag(const RID& p_area, AreaFlagJolt p_flag) const;
+
+	void area_set_jolt_flag(const RID& p_area, AreaFlagJolt p_flag, bool p_enabled);
+
+	Dictionary body_test_motions(
+		const TypedArray<RID>& p_bodies,
+		const TypedArray<Transform3D>& p_from,
+		const PackedVector3Array& p_motions,
+		real_t p_margin,
+		int32_t p_max_collisions,
+		bool p_collide_separation_ray,
+		bool p_recovery_as_collision
+	) const;
+
+	RID character_create();
+
+	RID character_get_space(const RID& p_character) const;
+
+	void character_set_space(const RID& p_character, const RID& p_space);
+
+	RID character_get_shape(const RID& p_character) const;
+
+	void character_set_shape(const RID& p_character, const RID& p_shape);
+
+	Transform3D character_get_transform(const RID& p_character) const;
+
+	void character_set_transform(const RID& p_character, const Transform3D& p_transform);
+
+	Vector3 character_get_velocity(const RID& p_character) const;
+
+	void character_set_velocity(const RID& p_character, const Vector3& p_velocity);
+
+	uint32_t character_get_collision_layer(const RID& p_character) const;
+
+	void character_set_collision_layer(const RID& p_character, uint32_t p_layer);
+
+	uint32_t character_get_collision_mask(const RID& p_character) const;
+
+	void character_set_collision_mask(const RID& p_character, uint32_t p_mask);
+
+	double character_get_jolt_param(const RID& p_character, CharacterParamJolt p_param) const;
+
+	void character_set_jolt_param(
+		const RID& p_character,
+		CharacterParamJolt p_param,
+		double p_value
+	);
+
+	CharacterGroundStateJolt character_get_ground_state(const RID& p_character) const;
+
+	Vector3 character_get_ground_normal(const RID& p_character) const;
+
+	Vector3 character_get_ground_velocity(const RID& p_character) const;
+
+	RID query_create(QueryTypeJolt p_type);
+
+	QueryTypeJolt query_get_type(const RID& p_query) const;
+
+	RID query_get_space(const RID& p_query) const;
+
+	void query_set_space(const RID& p_query, const RID& p_space);
+
+	RID query_get_shape(const RID& p_query) const;
+
+	void query_set_shape(const RID& p_query, const RID& p_shape);
+
+	Transform3D query_get_transform(const RID& p_query) const;
+
+	void query_set_transform(const RID& p_query, const Transform3D& p_transform);
+
+	Vector3 query_get_target_position(const RID& p_query) const;
+
+	void query_set_target_position(const RID& p_query, const Vector3& p_position);
+
+	float query_get_margin(const RID& p_query) const;
+
+	void query_set_margin(const RID& p_query, float p_margin);
+
+	uint32_t query_get_collision_mask(const RID& p_query) const;
+
+	void query_set_collision_mask(const RID& p_query, uint32_t p_mask);
+
+	bool query_get_jolt_flag(const RID& p_query, QueryFlagJolt p_flag) const;
+
+	void query_set_jolt_flag(const RID& p_query, QueryFlagJolt p_flag, bool p_enabled);
+
+	void query_add_exception(const RID& p_query, const RID& p_object);
+
+	void query_remove_exception(const RID& p_query, const RID& p_object);
+
+	void query_clear_exceptions(const RID& p_query);
+
+	bool query_is_colliding(const RID& p_query) const;
+
+	Dictionary query_get_result(const RID& p_query) const;
+
+	RID projectile_pool_create();
+
+	RID projectile_pool_get_space(const RID& p_pool) const;
+
+	void projectile_pool_set_space(const RID& p_pool, const RID& p_space);
+
+	uint32_t projectile_pool_get_collision_mask(const RID& p_pool) const;
+
+	void projectile_pool_set_collision_mask(const RID& p_pool, uint32_t p_mask);
+
+	double projectile_pool_get_jolt_param(const RID& p_pool, ProjectilePoolParamJolt p_param) const;
+
+	void projectile_pool_set_jolt_param(
+		const RID& p_pool,
+		ProjectilePoolParamJolt p_param,
+		double p_value
+	);
+
+	int64_t projectile_pool_spawn(
+		const RID& p_pool,
+		const Vector3& p_position,
+		const Vector3& p_velocity
+	);
+
+	void projectile_pool_clear(const RID& p_pool);
+
+	int32_t projectile_pool_get_count(const RID& p_pool) const;
+
+	PackedVector3Array projectile_pool_get_positions(const RID& p_pool) const;
+
+	Dictionary projectile_pool_get_impacts(const RID& p_pool) const;
+
 	bool joint_get_enabled(const RID& p_joint) const;
 
 	void joint_set_enabled(const RID& p_joint, bool p_enabled);
@@ -803,6 +999,12 @@ private:
 
 	mutable RID_PtrOwner<JoltSoftBodyImpl3D> soft_body_owner;
 
+	mutable RID_PtrOwner<JoltCharacterImpl3D> character_owner;
+
+	mutable RID_PtrOwner<JoltQueryImpl3D> query_owner;
+
+	mutable RID_PtrOwner<JoltProjectilePoolImpl3D> projectile_pool_owner;
+
 	mutable RID_PtrOwner<JoltShapeImpl3D> shape_owner;
 
 	mutable RID_PtrOwner<JoltJointImpl3D> joint_owner;
@@ -816,6 +1018,13 @@ private:
 	bool flushing_queries = false;
 };
 
+VARIANT_ENUM_CAST(JoltPhysicsServer3DExtension::AreaParamJolt)
+VARIANT_ENUM_CAST(JoltPhysicsServer3DExtension::AreaFlagJolt)
+VARIANT_ENUM_CAST(JoltPhysicsServer3DExtension::CharacterParamJolt)
+VARIANT_ENUM_CAST(JoltPhysicsServer3DExtension::CharacterGroundStateJolt)
+VARIANT_ENUM_CAST(JoltPhysicsServer3DExtension::ProjectilePoolParamJolt)
+VARIANT_ENUM_CAST(JoltPhysicsServer3DExtension::QueryTypeJolt)
+VARIANT_ENUM_CAST(JoltPhysicsServer3DExtension::QueryFlagJolt)
 VARIANT_ENUM_CAST(JoltPhysicsServer3DExtension::HingeJointParamJolt)
 VARIANT_ENUM_CAST(JoltPhysicsServer3DExtension::HingeJointFlagJolt)
 VARIANT_ENUM_CAST(JoltPhysicsServer3DExtension::SliderJointParamJolt)
@@ -17,6 +17,16 @@ constexpr char SHAPE_MARGINS[] = "physics/jolt_physics_extension_3d/collisions/u
 constexpr char BODY_EDGE_REMOVAL[] = "physics/jolt_physics_extension_3d/collisions/use_enhanced_internal_edge_removal";
 constexpr char KINEMATIC_CONTACTS[] = "physics/jolt_physics_extension_3d/collisions/report_all_kinematic_contacts";
 constexpr char SOFT_BODY_POINT_MARGIN[] = "physics/jolt_physics_extension_3d/collisions/soft_body_point_margin";
+constexpr char MUTABLE_COMPOUND_THRESHOLD[] = "physics/jolt_physics_extension_3d/collisions/mutable_compound_threshold";
+constexpr char SHAPE_INTERNING[] = "physics/jolt_physics_extension_3d/collisions/use_shape_interning";
+constexpr char BACKGROUND_COOKING[] = "physics/jolt_physics_extension_3d/collisions/use_background_shape_cooking";
+constexpr char SHAPE_CACHE[] = "physics/jolt_physics_extension_3d/collisions/use_shape_cache";
+constexpr char SHAPE_CACHE_DIRECTORY[] = "physics/jolt_physics_extension_3d/collisions/shape_cache_directory";
+constexpr char HEIGHT_MAP_TILE_SIZE[] = "physics/jolt_physics_extension_3d/collisions/height_map_tile_size";
+constexpr char HEIGHT_FIELD_MAX_ERROR[] = "physics/jolt_physics_extension_3d/collisions/height_field_max_error";
+constexpr char HEIGHT_FIELD_BLOCK_SIZE[] = "physics/jolt_physics_extension_3d/collisions/height_field_block_size";
+constexpr char CONVEX_HULL_MAX_POINTS[] = "physics/jolt_physics_extension_3d/collisions/convex_hull_max_points";
+constexpr char CONVEX_HULL_TOLERANCE[] = "physics/jolt_physics_extension_3d/collisions/convex_hull_tolerance";
 constexpr char PAIR_CACHE_ENABLED[] = "physics/jolt_physics_extension_3d/collisions/body_pair_cache_enabled";
 constexpr char PAIR_CACHE_DISTANCE[] = "physics/jolt_physics_extension_3d/collisions/body_pair_cache_distance_threshold";
 constexpr char PAIR_CACHE_ANGLE[] = "physics/jolt_physics_extension_3d/collisions/body_pair_cache_angle_threshold";
@@ -33,6 +43,9 @@ constexpr char RECOVERY_AMOUNT[] = "physics/jolt_physics_extension_3d/kinematics
 constexpr char QUERY_EDGE_REMOVAL[] = "physics/jolt_physics_extension_3d/queries/use_enhanced_internal_edge_removal";
 constexpr char LEGACY_RAY_CASTING[] = "physics/jolt_physics_extension_3d/queries/use_legacy_ray_casting";
 constexpr char RAY_FACE_INDEX[] = "physics/jolt_physics_extension_3d/queries/enable_ray_cast_face_index";
+constexpr char SWEPT_SHAPE_CASTING[] = "physics/jolt_physics_extension_3d/queries/use_swept_shape_casting";
+constexpr char CONCURRENT_QUERIES[] = "physics/jolt_physics_extension_3d/queries/allow_concurrent_queries";
+constexpr char QUERY_CACHE[] = "physics/jolt_physics_extension_3d/queries/use_query_cache";
 
 constexpr char POSITION_ITERATIONS[] = "physics/jolt_physics_extension_3d/solver/position_iterations";
 constexpr char VELOCITY_ITERATIONS[] = "physics/jolt_physics_extension_3d/solver/velocity_iterations";
@@ -238,6 +251,21 @@ void JoltProjectSettings::register_settings() {
 	register_setting_plain(KINEMATIC_CONTACTS, false);
 
 	register_setting_ranged(SOFT_BODY_POINT_MARGIN, 0.01f, U"0,1,0.001,or_greater,suffix:m");
+	register_setting_ranged(MUTABLE_COMPOUND_THRESHOLD, 8, U"0,64,or_greater");
+	register_setting_plain(SHAPE_INTERNING, false, true);
+	register_setting_plain(BACKGROUND_COOKING, false, true);
+	register_setting_plain(SHAPE_CACHE, false, true);
+	register_setting_plain(SHAPE_CACHE_DIRECTORY, "user://jolt_shape_cache", true);
+	register_setting_ranged(HEIGHT_MAP_TILE_SIZE, 0, U"0,4096,or_greater", true);
+	register_setting_ranged(HEIGHT_FIELD_MAX_ERROR, 0.0f, U"0,1,0.001,or_greater,suffix:m", true);
+	register_setting_ranged(HEIGHT_FIELD_BLOCK_SIZE, 2, U"2,8", true);
+	register_setting_ranged(CONVEX_HULL_MAX_POINTS, 0, U"0,256", true);
+	register_setting_ranged(
+		CONVEX_HULL_TOLERANCE,
+		0.001f,
+		U"0,0.1,0.0001,or_greater,suffix:m",
+		true
+	);
 
 	register_setting_enum(JOINT_WORLD_NODE, JOINT_WORLD_NODE_A, "Node A,Node B");
 
@@ -251,6 +279,9 @@ void JoltProjectSettings::register_settings() {
 	register_setting_plain(QUERY_EDGE_REMOVAL, false);
 	register_setting_plain(LEGACY_RAY_CASTING, false, true);
 	register_setting_plain(RAY_FACE_INDEX, false);
+	register_setting_plain(SWEPT_SHAPE_CASTING, false);
+	register_setting_plain(CONCURRENT_QUERIES, false, true);
+	register_setting_plain(QUERY_CACHE, false, true);
 
 	register_setting_ranged(VELOCITY_ITERATIONS, 10, U"2,16,or_greater");
 	register_setting_ranged(POSITION_ITERATIONS, 2, U"1,16,or_greater");
@@ -309,6 +340,60 @@ float JoltProjectSettings::get_soft_body_point_margin() {
 	return value;
 }
 
+int32_t JoltProjectSettings::get_mutable_compound_threshold() {
+	static const auto value = get_setting<int32_t>(MUTABLE_COMPOUND_THRESHOLD);
+	return value;
+}
+
+bool JoltProjectSettings::use_shape_interning() {
+	static const auto value = get_setting<bool>(SHAPE_INTERNING);
+	return value;
+}
+
+bool JoltProjectSettings::use_background_shape_cooking() {
+	static const auto value = get_setting<bool>(BACKGROUND_COOKING);
+	return value;
+}
+
+bool JoltProjectSettings::use_shape_cache() {
+	static const auto value = get_setting<bool>(SHAPE_CACHE);
+	return value;
+}
+
+String JoltProjectSettings::get_shape_cache_directory() {
+	// We don't cache this in a static like the others, since a static `String` would outlive the
+	// engine that it needs in order to free itself.
+	return get_setting<String>(SHAPE_CACHE_DIRECTORY);
+}
+
+int32_t JoltProjectSettings::get_height_map_tile_size() {
+	static const auto value = get_setting<int32_t>(HEIGHT_MAP_TILE_SIZE);
+	return value;
+}
+
+float JoltProjectSettings::get_height_field_max_error() {
+	static const auto value = get_setting<float>(HEIGHT_FIELD_MAX_ERROR);
+	return value;
+}
+
+int32_t JoltProjectSettings::get_height_field_block_size() {
+	static const auto value = CLAMP(get_setting<int32_t>(HEIGHT_FIELD_BLOCK_SIZE), 2, 8);
+	return value;
+}
+
+int32_t JoltProjectSettings::get_convex_hull_max_points() {
+	// Anything less than 4 points would leave the hull without any volume, so any such value
+	// (other than 0, which disables the simplification) is treated as 4.
+	static const auto setting_value = get_setting<int32_t>(CONVEX_HULL_MAX_POINTS);
+	static const auto value = setting_value > 0 ? MAX(setting_value, 4) : 0;
+	return value;
+}
+
+float JoltProjectSettings::get_convex_hull_tolerance() {
+	static const auto value = get_setting<float>(CONVEX_HULL_TOLERANCE);
+	return value;
+}
+
 bool JoltProjectSettings::use_joint_world_node_a() {
 	static const auto value = get_setting<int32_t>(JOINT_WORLD_NODE) == JOINT_WORLD_NODE_A;
 	return value;
@@ -354,6 +439,21 @@ bool JoltProjectSettings::enable_ray_cast_face_index() {
 	return value;
 }
 
+bool JoltProjectSettings::use_swept_shape_casting() {
+	static const auto value = get_setting<bool>(SWEPT_SHAPE_CASTING);
+	return value;
+}
+
+bool JoltProjectSettings::allow_concurrent_queries() {
+	static const auto value = get_setting<bool>(CONCURRENT_QUERIES);
+	return value;
+}
+
+bool JoltProjectSettings::use_query_cache() {
+	static const auto value = get_setting<bool>(QUERY_CACHE);
+	return value;
+}
+
 int32_t JoltProjectSettings::get_velocity_iterations() {
 	static const auto value = get_setting<int32_t>(VELOCITY_ITERATIONS);
 	return value;
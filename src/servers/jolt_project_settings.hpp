@@ -18,6 +18,26 @@ public:
 
 	static float get_soft_body_point_margin();
 
+	static int32_t get_mutable_compound_threshold();
+
+	static bool use_shape_interning();
+
+	static bool use_background_shape_cooking();
+
+	static bool use_shape_cache();
+
+	static String get_shape_cache_directory();
+
+	static int32_t get_height_map_tile_size();
+
+	static float get_height_field_max_error();
+
+	static int32_t get_height_field_block_size();
+
+	static int32_t get_convex_hull_max_points();
+
+	static float get_convex_hull_tolerance();
+
 	static bool use_joint_world_node_a();
 
 	static float get_ccd_movement_threshold();
@@ -36,6 +56,12 @@ public:
 
 	static bool enable_ray_cast_face_index();
 
+	static bool use_swept_shape_casting();
+
+	static bool allow_concurrent_queries();
+
+	static bool use_query_cache();
+
 	static int32_t get_velocity_iterations();
 
 	static int32_t get_position_iterations();
@@ -1,6 +1,32 @@
 #include "jolt_concave_polygon_shape_impl_3d.hpp"
 
 #include "servers/jolt_project_settings.hpp"
+#include "shapes/jolt_shape_cache.hpp"
+
+namespace {
+
+constexpr int32_t EXPENSIVE_TRIANGLE_COUNT = 4096;
+
+// Matches the default weld distance of `JPH::Indexify`, which is what Jolt would have used had we
+// given it an unindexed mesh.
+constexpr float VERTEX_WELD_DISTANCE = 1.0e-4f;
+
+constexpr float VERTEX_WELD_DISTANCE_SQ = VERTEX_WELD_DISTANCE * VERTEX_WELD_DISTANCE;
+
+constexpr JPH::uint32 NO_VERTEX = UINT32_MAX;
+
+Vector3i to_weld_cell(const JPH::Float3& p_vertex) {
+	// We clamp to the range of `int32_t` to stay clear of undefined behavior for very large
+	// coordinates, which just means more vertices will end up sharing the outermost cells.
+	const auto to_cell = [](float p_value) {
+		const double cell = Math::floor((double)p_value / (double)VERTEX_WELD_DISTANCE);
+		return (int32_t)CLAMP(cell, (double)INT32_MIN, (double)INT32_MAX);
+	};
+
+	return {to_cell(p_vertex.x), to_cell(p_vertex.y), to_cell(p_vertex.z)};
+}
+
+} // namespace
 
 Variant JoltConcavePolygonShapeImpl3D::get_data() const {
 	Dictionary data;
@@ -61,30 +87,109 @@ JPH::ShapeRefC JoltConcavePolygonShapeImpl3D::_build() const {
 		)
 	);
 
-	JPH::TriangleList jolt_faces;
+	const float active_edge_threshold = JoltProjectSettings::get_active_edge_threshold();
+	const bool per_triangle_user_data = JoltProjectSettings::enable_ray_cast_face_index();
+
+	Array cache_inputs;
+	cache_inputs.append((int32_t)get_type());
+	cache_inputs.append(faces);
+	cache_inputs.append(active_edge_threshold);
+	cache_inputs.append(per_triangle_user_data);
+
+	const String cache_path = JoltShapeCache::make_path(cache_inputs);
+
+	if (const JPH::ShapeRefC cached_shape = JoltShapeCache::load(cache_path)) {
+		return JoltShapeImpl3D::with_double_sided(cached_shape, back_face_collision);
+	}
+
+	// Every vertex in `faces` is typically shared by several triangles, so we weld vertices that
+	// lie within `VERTEX_WELD_DISTANCE` of each other together up front and give Jolt an indexed
+	// mesh, instead of an unindexed one that it would then have to index by itself. To find nearby
+	// vertices quickly we bucket them into a grid with cells the size of the weld distance, which
+	// means any vertex we could weld with is either in the same cell or in one of its neighbors.
+	HashMap<Vector3i, JPH::uint32> first_vertex_by_cell(vertex_count / 4);
+
+	JPH::VertexList jolt_vertices;
+	jolt_vertices.reserve((size_t)vertex_count / 4);
+
+	LocalVector<JPH::uint32> next_vertex_in_cell;
+	next_vertex_in_cell.reserve(vertex_count / 4);
+
+	JPH::IndexedTriangleList jolt_faces;
 	jolt_faces.reserve((size_t)face_count);
 
+	const auto find_vertex_in_cell = [&](const Vector3i& p_cell, const JPH::Vec3& p_vertex) {
+		const JPH::uint32* first_index = first_vertex_by_cell.getptr(p_cell);
+
+		if (first_index == nullptr) {
+			return NO_VERTEX;
+		}
+
+		for (JPH::uint32 index = *first_index; index != NO_VERTEX;) {
+			const JPH::Vec3 other_vertex(jolt_vertices[index]);
+
+			if ((other_vertex - p_vertex).LengthSq() <= VERTEX_WELD_DISTANCE_SQ) {
+				return index;
+			}
+
+			index = next_vertex_in_cell[index];
+		}
+
+		return NO_VERTEX;
+	};
+
+	const auto weld_vertex = [&](const Vector3& p_vertex) {
+		const JPH::Float3 vertex((float)p_vertex.x, (float)p_vertex.y, (float)p_vertex.z);
+		const JPH::Vec3 vertex_vec(vertex);
+
+		const Vector3i cell = to_weld_cell(vertex);
+
+		// Most shared vertices are exact duplicates, so we check the vertex's own cell first.
+		JPH::uint32 index = find_vertex_in_cell(cell, vertex_vec);
+
+		for (int32_t z = -1; z <= 1 && index == NO_VERTEX; ++z) {
+			for (int32_t y = -1; y <= 1 && index == NO_VERTEX; ++y) {
+				for (int32_t x = -1; x <= 1 && index == NO_VERTEX; ++x) {
+					if (x != 0 || y != 0 || z != 0) {
+						index = find_vertex_in_cell(cell + Vector3i(x, y, z), vertex_vec);
+					}
+				}
+			}
+		}
+
+		if (index != NO_VERTEX) {
+			return index;
+		}
+
+		const auto new_index = (JPH::uint32)jolt_vertices.size();
+		jolt_vertices.push_back(vertex);
+
+		if (JPH::uint32* first_index = first_vertex_by_cell.getptr(cell)) {
+			next_vertex_in_cell.push_back(*first_index);
+			*first_index = new_index;
+		} else {
+			next_vertex_in_cell.push_back(NO_VERTEX);
+			first_vertex_by_cell.insert(cell, new_index);
+		}
+
+		return new_index;
+	};
+
 	const Vector3* faces_begin = &faces[0];
 	const Vector3* faces_end = faces_begin + vertex_count;
 	JPH::uint32 triangle_index = 0;
 
 	for (const Vector3* vertex = faces_begin; vertex != faces_end; vertex += 3) {
-		const Vector3* v0 = vertex + 0;
-		const Vector3* v1 = vertex + 1;
-		const Vector3* v2 = vertex + 2;
-
-		jolt_faces.emplace_back(
-			JPH::Float3((float)v2->x, (float)v2->y, (float)v2->z),
-			JPH::Float3((float)v1->x, (float)v1->y, (float)v1->z),
-			JPH::Float3((float)v0->x, (float)v0->y, (float)v0->z),
-			0,
-			triangle_index++
-		);
+		const JPH::uint32 i0 = weld_vertex(vertex[0]);
+		const JPH::uint32 i1 = weld_vertex(vertex[1]);
+		const JPH::uint32 i2 = weld_vertex(vertex[2]);
+
+		jolt_faces.emplace_back(i2, i1, i0, 0, triangle_index++);
 	}
 
-	JPH::MeshShapeSettings shape_settings(jolt_faces);
-	shape_settings.mActiveEdgeCosThresholdAngle = JoltProjectSettings::get_active_edge_threshold();
-	shape_settings.mPerTriangleUserData = JoltProjectSettings::enable_ray_cast_face_index();
+	JPH::MeshShapeSettings shape_settings(std::move(jolt_vertices), std::move(jolt_faces));
+	shape_settings.mActiveEdgeCosThresholdAngle = active_edge_threshold;
+	shape_settings.mPerTriangleUserData = per_triangle_user_data;
 
 	const JPH::ShapeSettings::ShapeResult shape_result = shape_settings.Create();
 
@@ -100,9 +205,23 @@ JPH::ShapeRefC JoltConcavePolygonShapeImpl3D::_build() const {
 		)
 	);
 
+	JoltShapeCache::save(cache_path, shape_result.Get());
+
 	return JoltShapeImpl3D::with_double_sided(shape_result.Get(), back_face_collision);
 }
 
+bool JoltConcavePolygonShapeImpl3D::_is_expensive_to_build() const {
+	return faces.size() / 3 >= EXPENSIVE_TRIANGLE_COUNT;
+}
+
+void JoltConcavePolygonShapeImpl3D::_hash_intern_data(const Ref<HashingContext>& p_context) const {
+	PackedByteArray flags;
+	flags.append(back_face_collision ? 1 : 0);
+
+	p_context->update(flags);
+	p_context->update(faces.to_byte_array());
+}
+
 AABB JoltConcavePolygonShapeImpl3D::_calculate_aabb() const {
 	AABB result;
 
@@ -1,6 +1,59 @@
 #include "jolt_convex_polygon_shape_impl_3d.hpp"
 
 #include "servers/jolt_project_settings.hpp"
+#include "shapes/jolt_shape_cache.hpp"
+
+namespace {
+
+JPH::Array<JPH::Vec3> reduce_hull_points(
+	const JPH::Array<JPH::Vec3>& p_points,
+	int32_t p_max_points,
+	float p_tolerance
+) {
+	JPH::ConvexHullBuilder builder(p_points);
+
+	const char* error = nullptr;
+	const JPH::ConvexHullBuilder::EResult result = builder.Initialize(
+		p_max_points,
+		p_tolerance,
+		error
+	);
+
+	// Any failure here will be reported properly when building the actual shape, so we just let
+	// that deal with the original points instead.
+	if (result != JPH::ConvexHullBuilder::EResult::Success &&
+		result != JPH::ConvexHullBuilder::EResult::MaxVerticesReached) {
+		return p_points;
+	}
+
+	HashSet<int32_t> hull_indices;
+
+	for (const JPH::ConvexHullBuilder::Face* face : builder.GetFaces()) {
+		if (face->mRemoved) {
+			continue;
+		}
+
+		const JPH::ConvexHullBuilder::Edge* edge = face->mFirstEdge;
+
+		do {
+			hull_indices.insert(edge->mStartIdx);
+			edge = edge->mNextEdge;
+		} while (edge != face->mFirstEdge);
+	}
+
+	JPH::Array<JPH::Vec3> reduced_points;
+	reduced_points.reserve(hull_indices.size());
+
+	for (int32_t i = 0; i < (int32_t)p_points.size(); ++i) {
+		if (hull_indices.has(i)) {
+			reduced_points.push_back(p_points[(size_t)i]);
+		}
+	}
+
+	return reduced_points;
+}
+
+} // namespace
 
 Variant JoltConvexPolygonShapeImpl3D::get_data() const {
 	return vertices;
@@ -45,6 +98,23 @@ JPH::ShapeRefC JoltConvexPolygonShapeImpl3D::_build() const {
 		)
 	);
 
+	const float actual_margin = JoltProjectSettings::use_shape_margins() ? margin : 0.0f;
+	const int32_t max_points = JoltProjectSettings::get_convex_hull_max_points();
+	const float tolerance = JoltProjectSettings::get_convex_hull_tolerance();
+
+	Array cache_inputs;
+	cache_inputs.append((int32_t)get_type());
+	cache_inputs.append(vertices);
+	cache_inputs.append(actual_margin);
+	cache_inputs.append(max_points);
+	cache_inputs.append(tolerance);
+
+	const String cache_path = JoltShapeCache::make_path(cache_inputs);
+
+	if (const JPH::ShapeRefC cached_shape = JoltShapeCache::load(cache_path)) {
+		return cached_shape;
+	}
+
 	JPH::Array<JPH::Vec3> jolt_vertices;
 	jolt_vertices.reserve((size_t)vertex_count);
 
@@ -55,9 +125,15 @@ JPH::ShapeRefC JoltConvexPolygonShapeImpl3D::_build() const {
 		jolt_vertices.emplace_back((float)vertex->x, (float)vertex->y, (float)vertex->z);
 	}
 
-	const float actual_margin = JoltProjectSettings::use_shape_margins() ? margin : 0.0f;
+	// High-poly hulls make every GJK/EPA iteration against them more expensive, so we let Jolt's
+	// hull builder pick the points that matter the most and drop the rest.
+	if (max_points > 0 && vertex_count > max_points) {
+		jolt_vertices = reduce_hull_points(jolt_vertices, max_points, tolerance);
+	}
+
+	JPH::ConvexHullShapeSettings shape_settings(jolt_vertices, actual_margin);
+	shape_settings.mHullTolerance = tolerance;
 
-	const JPH::ConvexHullShapeSettings shape_settings(jolt_vertices, actual_margin);
 	const JPH::ShapeSettings::ShapeResult shape_result = shape_settings.Create();
 
 	ERR_FAIL_COND_D_MSG(
@@ -72,9 +148,15 @@ JPH::ShapeRefC JoltConvexPolygonShapeImpl3D::_build() const {
 		)
 	);
 
+	JoltShapeCache::save(cache_path, shape_result.Get());
+
 	return shape_result.Get();
 }
 
+void JoltConvexPolygonShapeImpl3D::_hash_intern_data(const Ref<HashingContext>& p_context) const {
+	p_context->update(vertices.to_byte_array());
+}
+
 AABB JoltConvexPolygonShapeImpl3D::_calculate_aabb() const {
 	AABB result;
 
@@ -23,6 +23,10 @@ public:
 private:
 	JPH::ShapeRefC _build() const override;
 
+	bool _can_be_interned() const override { return true; }
+
+	void _hash_intern_data(const Ref<HashingContext>& p_context) const override;
+
 	AABB _calculate_aabb() const;
 
 	AABB aabb;
@@ -0,0 +1,507 @@
+#include "jolt_custom_fused_shape.hpp"
+
+#include "servers/jolt_project_settings.hpp"
+
+namespace {
+
+JPH::Shape* construct_fused() {
+	return new JoltCustomFusedShape();
+}
+
+void collide_fused_vs_shape(
+	const JPH::Shape* p_shape1,
+	const JPH::Shape* p_shape2,
+	JPH::Vec3Arg p_scale1,
+	JPH::Vec3Arg p_scale2,
+	JPH::Mat44Arg p_center_of_mass_transform1,
+	JPH::Mat44Arg p_center_of_mass_transform2,
+	const JPH::SubShapeIDCreator& p_sub_shape_id_creator1,
+	const JPH::SubShapeIDCreator& p_sub_shape_id_creator2,
+	const JPH::CollideShapeSettings& p_collide_shape_settings,
+	JPH::CollideShapeCollector& p_collector,
+	const JPH::ShapeFilter& p_shape_filter
+) {
+	ERR_FAIL_COND(p_shape1->GetSubType() != JoltCustomShapeSubType::FUSED);
+
+	const auto* shape1 = static_cast<const JoltCustomFusedShape*>(p_shape1);
+
+	const JPH::Vec3 inner_scale1 = shape1->to_inner_scale(p_scale1);
+
+	JPH::CollideShapeSettings new_collide_shape_settings = p_collide_shape_settings;
+
+	if (shape1->should_collide_with_back_faces()) {
+		new_collide_shape_settings.mBackFaceMode = JPH::EBackFaceMode::CollideWithBackFaces;
+	}
+
+	JPH::CollisionDispatch::sCollideShapeVsShape(
+		shape1->GetInnerShape(),
+		p_shape2,
+		inner_scale1,
+		p_scale2,
+		shape1->to_inner_transform(p_center_of_mass_transform1, inner_scale1),
+		p_center_of_mass_transform2,
+		p_sub_shape_id_creator1,
+		p_sub_shape_id_creator2,
+		new_collide_shape_settings,
+		p_collector,
+		p_shape_filter
+	);
+}
+
+void collide_shape_vs_fused(
+	const JPH::Shape* p_shape1,
+	const JPH::Shape* p_shape2,
+	JPH::Vec3Arg p_scale1,
+	JPH::Vec3Arg p_scale2,
+	JPH::Mat44Arg p_center_of_mass_transform1,
+	JPH::Mat44Arg p_center_of_mass_transform2,
+	const JPH::SubShapeIDCreator& p_sub_shape_id_creator1,
+	const JPH::SubShapeIDCreator& p_sub_shape_id_creator2,
+	const JPH::CollideShapeSettings& p_collide_shape_settings,
+	JPH::CollideShapeCollector& p_collector,
+	const JPH::ShapeFilter& p_shape_filter
+) {
+	ERR_FAIL_COND(p_shape2->GetSubType() != JoltCustomShapeSubType::FUSED);
+
+	const auto* shape2 = static_cast<const JoltCustomFusedShape*>(p_shape2);
+
+	const JPH::Vec3 inner_scale2 = shape2->to_inner_scale(p_scale2);
+
+	JPH::CollideShapeSettings new_collide_shape_settings = p_collide_shape_settings;
+
+	if (shape2->should_collide_with_back_faces()) {
+		new_collide_shape_settings.mBackFaceMode = JPH::EBackFaceMode::CollideWithBackFaces;
+	}
+
+	JPH::CollisionDispatch::sCollideShapeVsShape(
+		p_shape1,
+		shape2->GetInnerShape(),
+		p_scale1,
+		inner_scale2,
+		p_center_of_mass_transform1,
+		shape2->to_inner_transform(p_center_of_mass_transform2, inner_scale2),
+		p_sub_shape_id_creator1,
+		p_sub_shape_id_creator2,
+		new_collide_shape_settings,
+		p_collector,
+		p_shape_filter
+	);
+}
+
+void cast_fused_vs_shape(
+	const JPH::ShapeCast& p_shape_cast,
+	const JPH::ShapeCastSettings& p_shape_cast_settings,
+	const JPH::Shape* p_shape,
+	JPH::Vec3Arg p_scale,
+	const JPH::ShapeFilter& p_shape_filter,
+	JPH::Mat44Arg p_center_of_mass_transform2,
+	const JPH::SubShapeIDCreator& p_sub_shape_id_creator1,
+	const JPH::SubShapeIDCreator& p_sub_shape_id_creator2,
+	JPH::CastShapeCollector& p_collector
+) {
+	ERR_FAIL_COND(p_shape_cast.mShape->GetSubType() != JoltCustomShapeSubType::FUSED);
+
+	const auto* shape = static_cast<const JoltCustomFusedShape*>(p_shape_cast.mShape);
+
+	const JPH::Vec3 inner_scale = shape->to_inner_scale(p_shape_cast.mScale);
+
+	const JPH::ShapeCast shape_cast(
+		shape->GetInnerShape(),
+		inner_scale,
+		shape->to_inner_transform(p_shape_cast.mCenterOfMassStart, inner_scale),
+		p_shape_cast.mDirection
+	);
+
+	JPH::CollisionDispatch::sCastShapeVsShapeLocalSpace(
+		shape_cast,
+		p_shape_cast_settings,
+		p_shape,
+		p_scale,
+		p_shape_filter,
+		p_center_of_mass_transform2,
+		p_sub_shape_id_creator1,
+		p_sub_shape_id_creator2,
+		p_collector
+	);
+}
+
+void cast_shape_vs_fused(
+	const JPH::ShapeCast& p_shape_cast,
+	const JPH::ShapeCastSettings& p_shape_cast_settings,
+	const JPH::Shape* p_shape,
+	JPH::Vec3Arg p_scale,
+	const JPH::ShapeFilter& p_shape_filter,
+	JPH::Mat44Arg p_center_of_mass_transform2,
+	const JPH::SubShapeIDCreator& p_sub_shape_id_creator1,
+	const JPH::SubShapeIDCreator& p_sub_shape_id_creator2,
+	JPH::CastShapeCollector& p_collector
+) {
+	ERR_FAIL_COND(p_shape->GetSubType() != JoltCustomShapeSubType::FUSED);
+
+	const auto* shape = static_cast<const JoltCustomFusedShape*>(p_shape);
+
+	const JPH::Vec3 inner_scale = shape->to_inner_scale(p_scale);
+
+	JPH::ShapeCastSettings new_shape_cast_settings = p_shape_cast_settings;
+
+	if (shape->should_collide_with_back_faces()) {
+		new_shape_cast_settings.mBackFaceModeTriangles = JPH::EBackFaceMode::CollideWithBackFaces;
+	}
+
+	JPH::CollisionDispatch::sCastShapeVsShapeLocalSpace(
+		p_shape_cast,
+		new_shape_cast_settings,
+		shape->GetInnerShape(),
+		inner_scale,
+		p_shape_filter,
+		shape->to_inner_transform(p_center_of_mass_transform2, inner_scale),
+		p_sub_shape_id_creator1,
+		p_sub_shape_id_creator2,
+		p_collector
+	);
+}
+
+} // namespace
+
+JPH::ShapeSettings::ShapeResult JoltCustomFusedShapeSettings::Create() const {
+	if (mCachedResult.IsEmpty()) {
+		new JoltCustomFusedShape(*this, mCachedResult);
+	}
+
+	return mCachedResult;
+}
+
+JoltCustomFusedShape::JoltCustomFusedShape(
+	const JoltCustomFusedShapeSettings& p_settings,
+	JPH::Shape::ShapeResult& p_result
+)
+	: JoltCustomDecoratedShape(JoltCustomShapeSubType::FUSED, p_settings, p_result)
+	, scale(p_settings.scale)
+	, center_of_mass_offset(p_settings.center_of_mass_offset)
+	, override_user_data(p_settings.override_user_data)
+	, double_sided(p_settings.double_sided)
+	, back_face_collision(p_settings.back_face_collision) {
+	if (p_result.HasError()) {
+		return;
+	}
+
+	if (JPH::ScaleHelpers::IsZeroScale(scale)) {
+		p_result.SetError("Can't use zero scale!");
+		return;
+	}
+
+	p_result.Set(this);
+}
+
+void JoltCustomFusedShape::register_type() {
+	JPH::ShapeFunctions& shape_functions = JPH::ShapeFunctions::sGet(JoltCustomShapeSubType::FUSED);
+
+	shape_functions.mConstruct = construct_fused;
+	shape_functions.mColor = JPH::Color::sCyan;
+
+	for (const JPH::EShapeSubType sub_type : JPH::sAllSubShapeTypes) {
+		JPH::CollisionDispatch::sRegisterCollideShape(
+			JoltCustomShapeSubType::FUSED,
+			sub_type,
+			collide_fused_vs_shape
+		);
+
+		JPH::CollisionDispatch::sRegisterCollideShape(
+			sub_type,
+			JoltCustomShapeSubType::FUSED,
+			collide_shape_vs_fused
+		);
+
+		JPH::CollisionDispatch::sRegisterCastShape(
+			JoltCustomShapeSubType::FUSED,
+			sub_type,
+			cast_fused_vs_shape
+		);
+
+		JPH::CollisionDispatch::sRegisterCastShape(
+			sub_type,
+			JoltCustomShapeSubType::FUSED,
+			cast_shape_vs_fused
+		);
+	}
+}
+
+JPH::AABox JoltCustomFusedShape::GetLocalBounds() const {
+	JPH::AABox bounds = mInnerShape->GetLocalBounds();
+	bounds.mMin -= center_of_mass_offset;
+	bounds.mMax -= center_of_mass_offset;
+
+	return bounds.Scaled(scale);
+}
+
+JPH::AABox JoltCustomFusedShape::GetWorldSpaceBounds(
+	JPH::Mat44Arg p_center_of_mass_transform,
+	JPH::Vec3Arg p_scale
+) const {
+	const JPH::Vec3 inner_scale = to_inner_scale(p_scale);
+
+	return mInnerShape->GetWorldSpaceBounds(
+		to_inner_transform(p_center_of_mass_transform, inner_scale),
+		inner_scale
+	);
+}
+
+JPH::MassProperties JoltCustomFusedShape::GetMassProperties() const {
+	// Offsetting the center of mass leaves the inertia untouched, so only the scale applies here.
+	JPH::MassProperties mass_properties = mInnerShape->GetMassProperties();
+	mass_properties.Scale(scale);
+
+	return mass_properties;
+}
+
+JPH::Vec3 JoltCustomFusedShape::GetSurfaceNormal(
+	const JPH::SubShapeID& p_sub_shape_id,
+	JPH::Vec3Arg p_local_surface_position
+) const {
+	const JPH::Vec3 inner_normal = mInnerShape->GetSurfaceNormal(
+		p_sub_shape_id,
+		to_inner_point(p_local_surface_position)
+	);
+
+	return (inner_normal / scale).Normalized();
+}
+
+void JoltCustomFusedShape::GetSupportingFace(
+	const JPH::SubShapeID& p_sub_shape_id,
+	JPH::Vec3Arg p_direction,
+	JPH::Vec3Arg p_scale,
+	JPH::Mat44Arg p_center_of_mass_transform,
+	SupportingFace& p_vertices
+) const {
+	const JPH::Vec3 inner_scale = to_inner_scale(p_scale);
+
+	mInnerShape->GetSupportingFace(
+		p_sub_shape_id,
+		p_direction,
+		inner_scale,
+		to_inner_transform(p_center_of_mass_transform, inner_scale),
+		p_vertices
+	);
+}
+
+JPH::TransformedShape JoltCustomFusedShape::GetSubShapeTransformedShape(
+	const JPH::SubShapeID& p_sub_shape_id,
+	JPH::Vec3Arg p_position_com,
+	JPH::QuatArg p_rotation,
+	JPH::Vec3Arg p_scale,
+	JPH::SubShapeID& p_remainder
+) const {
+	const JPH::Vec3 inner_scale = to_inner_scale(p_scale);
+
+	return mInnerShape->GetSubShapeTransformedShape(
+		p_sub_shape_id,
+		to_inner_position(p_position_com, p_rotation, inner_scale),
+		p_rotation,
+		inner_scale,
+		p_remainder
+	);
+}
+
+// clang-format off
+
+void JoltCustomFusedShape::GetSubmergedVolume(
+	JPH::Mat44Arg p_center_of_mass_transform,
+	JPH::Vec3Arg p_scale,
+	const JPH::Plane& p_surface,
+	float& p_total_volume,
+	float& p_submerged_volume,
+	JPH::Vec3& p_center_of_buoyancy
+	JPH_IF_DEBUG_RENDERER(, JPH::RVec3Arg p_base_offset)
+) const {
+	const JPH::Vec3 inner_scale = to_inner_scale(p_scale);
+
+	mInnerShape->GetSubmergedVolume(
+		to_inner_transform(p_center_of_mass_transform, inner_scale),
+		inner_scale,
+		p_surface,
+		p_total_volume,
+		p_submerged_volume,
+		p_center_of_buoyancy
+		JPH_IF_DEBUG_RENDERER(, p_base_offset)
+	);
+}
+
+// clang-format on
+
+#ifdef JPH_DEBUG_RENDERER
+
+void JoltCustomFusedShape::Draw(
+	JPH::DebugRenderer* p_renderer,
+	JPH::RMat44Arg p_center_of_mass_transform,
+	JPH::Vec3Arg p_scale,
+	JPH::ColorArg p_color,
+	bool p_use_material_colors,
+	bool p_draw_wireframe
+) const {
+	const JPH::Vec3 inner_scale = to_inner_scale(p_scale);
+
+	mInnerShape->Draw(
+		p_renderer,
+		p_center_of_mass_transform.PreTranslated(-inner_scale * center_of_mass_offset),
+		inner_scale,
+		p_color,
+		p_use_material_colors,
+		p_draw_wireframe
+	);
+}
+
+void JoltCustomFusedShape::DrawGetSupportFunction(
+	JPH::DebugRenderer* p_renderer,
+	JPH::RMat44Arg p_center_of_mass_transform,
+	JPH::Vec3Arg p_scale,
+	JPH::ColorArg p_color,
+	bool p_draw_support_direction
+) const {
+	const JPH::Vec3 inner_scale = to_inner_scale(p_scale);
+
+	mInnerShape->DrawGetSupportFunction(
+		p_renderer,
+		p_center_of_mass_transform.PreTranslated(-inner_scale * center_of_mass_offset),
+		inner_scale,
+		p_color,
+		p_draw_support_direction
+	);
+}
+
+void JoltCustomFusedShape::DrawGetSupportingFace(
+	JPH::DebugRenderer* p_renderer,
+	JPH::RMat44Arg p_center_of_mass_transform,
+	JPH::Vec3Arg p_scale
+) const {
+	const JPH::Vec3 inner_scale = to_inner_scale(p_scale);
+
+	mInnerShape->DrawGetSupportingFace(
+		p_renderer,
+		p_center_of_mass_transform.PreTranslated(-inner_scale * center_of_mass_offset),
+		inner_scale
+	);
+}
+
+#endif // JPH_DEBUG_RENDERER
+
+bool JoltCustomFusedShape::CastRay(
+	const JPH::RayCast& p_ray,
+	const JPH::SubShapeIDCreator& p_sub_shape_id_creator,
+	JPH::RayCastResult& p_hit
+) const {
+	const JPH::RayCast inner_ray = {to_inner_point(p_ray.mOrigin), p_ray.mDirection / scale};
+
+	return mInnerShape->CastRay(inner_ray, p_sub_shape_id_creator, p_hit);
+}
+
+void JoltCustomFusedShape::CastRay(
+	const JPH::RayCast& p_ray,
+	const JPH::RayCastSettings& p_ray_cast_settings,
+	const JPH::SubShapeIDCreator& p_sub_shape_id_creator,
+	JPH::CastRayCollector& p_collector,
+	const JPH::ShapeFilter& p_shape_filter
+) const {
+	const JPH::RayCast inner_ray = {to_inner_point(p_ray.mOrigin), p_ray.mDirection / scale};
+
+	JPH::RayCastSettings new_ray_cast_settings = p_ray_cast_settings;
+
+	if (double_sided && !back_face_collision && !JoltProjectSettings::use_legacy_ray_casting()) {
+		new_ray_cast_settings.SetBackFaceMode(JPH::EBackFaceMode::IgnoreBackFaces);
+	}
+
+	mInnerShape->CastRay(
+		inner_ray,
+		new_ray_cast_settings,
+		p_sub_shape_id_creator,
+		p_collector,
+		p_shape_filter
+	);
+}
+
+void JoltCustomFusedShape::CollidePoint(
+	JPH::Vec3Arg p_point,
+	const JPH::SubShapeIDCreator& p_sub_shape_id_creator,
+	JPH::CollidePointCollector& p_collector,
+	const JPH::ShapeFilter& p_shape_filter
+) const {
+	mInnerShape->CollidePoint(
+		to_inner_point(p_point),
+		p_sub_shape_id_creator,
+		p_collector,
+		p_shape_filter
+	);
+}
+
+void JoltCustomFusedShape::CollideSoftBodyVertices(
+	JPH::Mat44Arg p_center_of_mass_transform,
+	JPH::Vec3Arg p_scale,
+	const JPH::CollideSoftBodyVertexIterator& p_vertices,
+	JPH::uint p_num_vertices,
+	int p_colliding_shape_index
+) const {
+	const JPH::Vec3 inner_scale = to_inner_scale(p_scale);
+
+	mInnerShape->CollideSoftBodyVertices(
+		to_inner_transform(p_center_of_mass_transform, inner_scale),
+		inner_scale,
+		p_vertices,
+		p_num_vertices,
+		p_colliding_shape_index
+	);
+}
+
+void JoltCustomFusedShape::CollectTransformedShapes(
+	const JPH::AABox& p_box,
+	JPH::Vec3Arg p_position_com,
+	JPH::QuatArg p_rotation,
+	JPH::Vec3Arg p_scale,
+	const JPH::SubShapeIDCreator& p_sub_shape_id_creator,
+	JPH::TransformedShapeCollector& p_collector,
+	const JPH::ShapeFilter& p_shape_filter
+) const {
+	const JPH::Vec3 inner_scale = to_inner_scale(p_scale);
+
+	mInnerShape->CollectTransformedShapes(
+		p_box,
+		to_inner_position(p_position_com, p_rotation, inner_scale),
+		p_rotation,
+		inner_scale,
+		p_sub_shape_id_creator,
+		p_collector,
+		p_shape_filter
+	);
+}
+
+void JoltCustomFusedShape::TransformShape(
+	JPH::Mat44Arg p_center_of_mass_transform,
+	JPH::TransformedShapeCollector& p_collector
+) const {
+	const JPH::Mat44 scaled_transform = p_center_of_mass_transform * JPH::Mat44::sScale(scale);
+
+	mInnerShape->TransformShape(
+		scaled_transform.PreTranslated(-center_of_mass_offset),
+		p_collector
+	);
+}
+
+void JoltCustomFusedShape::GetTrianglesStart(
+	GetTrianglesContext& p_context,
+	const JPH::AABox& p_box,
+	JPH::Vec3Arg p_position_com,
+	JPH::QuatArg p_rotation,
+	JPH::Vec3Arg p_scale
+) const {
+	const JPH::Vec3 inner_scale = to_inner_scale(p_scale);
+
+	mInnerShape->GetTrianglesStart(
+		p_context,
+		p_box,
+		to_inner_position(p_position_com, p_rotation, inner_scale),
+		p_rotation,
+		inner_scale
+	);
+}
+
+float JoltCustomFusedShape::GetVolume() const {
+	return Math::abs(scale.GetX() * scale.GetY() * scale.GetZ()) * mInnerShape->GetVolume();
+}
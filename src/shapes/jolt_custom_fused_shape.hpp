@@ -0,0 +1,228 @@
+#pragma once
+
+#include "shapes/jolt_custom_decorated_shape.hpp"
+#include "shapes/jolt_custom_shape_type.hpp"
+
+class JoltCustomFusedShapeSettings final : public JoltCustomDecoratedShapeSettings {
+public:
+	using JoltCustomDecoratedShapeSettings::JoltCustomDecoratedShapeSettings;
+
+	JPH::Shape::ShapeResult Create() const override;
+
+	JPH::Vec3 scale = JPH::Vec3::sReplicate(1.0f);
+
+	JPH::Vec3 center_of_mass_offset = JPH::Vec3::sZero();
+
+	bool override_user_data = false;
+
+	bool double_sided = false;
+
+	bool back_face_collision = false;
+};
+
+// Combines what would otherwise be a `JoltCustomUserDataShape`, an `OffsetCenterOfMassShape`, a
+// `ScaledShape` and a `JoltCustomDoubleSidedShape` (in that order, from the inside out) into a
+// single decorator, to save on allocations and on the virtual calls made through each layer.
+class JoltCustomFusedShape final : public JoltCustomDecoratedShape {
+public:
+	static void register_type();
+
+	JoltCustomFusedShape()
+		: JoltCustomDecoratedShape(JoltCustomShapeSubType::FUSED) { }
+
+	JoltCustomFusedShape(
+		const JoltCustomFusedShapeSettings& p_settings,
+		JPH::Shape::ShapeResult& p_result
+	);
+
+	JPH::Vec3 GetCenterOfMass() const override {
+		return scale * (mInnerShape->GetCenterOfMass() + center_of_mass_offset);
+	}
+
+	JPH::AABox GetLocalBounds() const override;
+
+	JPH::AABox GetWorldSpaceBounds(
+		JPH::Mat44Arg p_center_of_mass_transform,
+		JPH::Vec3Arg p_scale
+	) const override;
+
+	float GetInnerRadius() const override {
+		return scale.Abs().ReduceMin() * mInnerShape->GetInnerRadius();
+	}
+
+	JPH::MassProperties GetMassProperties() const override;
+
+	JPH::Vec3 GetSurfaceNormal(
+		const JPH::SubShapeID& p_sub_shape_id,
+		JPH::Vec3Arg p_local_surface_position
+	) const override;
+
+	void GetSupportingFace(
+		const JPH::SubShapeID& p_sub_shape_id,
+		JPH::Vec3Arg p_direction,
+		JPH::Vec3Arg p_scale,
+		JPH::Mat44Arg p_center_of_mass_transform,
+		SupportingFace& p_vertices
+	) const override;
+
+	JPH::uint64 GetSubShapeUserData(const JPH::SubShapeID& p_sub_shape_id) const override {
+		if (override_user_data) {
+			return GetUserData();
+		}
+
+		return mInnerShape->GetSubShapeUserData(p_sub_shape_id);
+	}
+
+	JPH::TransformedShape GetSubShapeTransformedShape(
+		const JPH::SubShapeID& p_sub_shape_id,
+		JPH::Vec3Arg p_position_com,
+		JPH::QuatArg p_rotation,
+		JPH::Vec3Arg p_scale,
+		JPH::SubShapeID& p_remainder
+	) const override;
+
+	// clang-format off
+
+	void GetSubmergedVolume(
+		JPH::Mat44Arg p_center_of_mass_transform,
+		JPH::Vec3Arg p_scale,
+		const JPH::Plane& p_surface,
+		float& p_total_volume,
+		float& p_submerged_volume,
+		JPH::Vec3& p_center_of_buoyancy
+		JPH_IF_DEBUG_RENDERER(, JPH::RVec3Arg p_base_offset)
+	) const override;
+
+	// clang-format on
+
+#ifdef JPH_DEBUG_RENDERER
+	void Draw(
+		JPH::DebugRenderer* p_renderer,
+		JPH::RMat44Arg p_center_of_mass_transform,
+		JPH::Vec3Arg p_scale,
+		JPH::ColorArg p_color,
+		bool p_use_material_colors,
+		bool p_draw_wireframe
+	) const override;
+
+	void DrawGetSupportFunction(
+		JPH::DebugRenderer* p_renderer,
+		JPH::RMat44Arg p_center_of_mass_transform,
+		JPH::Vec3Arg p_scale,
+		JPH::ColorArg p_color,
+		bool p_draw_support_direction
+	) const override;
+
+	void DrawGetSupportingFace(
+		JPH::DebugRenderer* p_renderer,
+		JPH::RMat44Arg p_center_of_mass_transform,
+		JPH::Vec3Arg p_scale
+	) const override;
+#endif // JPH_DEBUG_RENDERER
+
+	bool CastRay(
+		const JPH::RayCast& p_ray,
+		const JPH::SubShapeIDCreator& p_sub_shape_id_creator,
+		JPH::RayCastResult& p_hit
+	) const override;
+
+	void CastRay(
+		const JPH::RayCast& p_ray,
+		const JPH::RayCastSettings& p_ray_cast_settings,
+		const JPH::SubShapeIDCreator& p_sub_shape_id_creator,
+		JPH::CastRayCollector& p_collector,
+		const JPH::ShapeFilter& p_shape_filter = {}
+	) const override;
+
+	void CollidePoint(
+		JPH::Vec3Arg p_point,
+		const JPH::SubShapeIDCreator& p_sub_shape_id_creator,
+		JPH::CollidePointCollector& p_collector,
+		const JPH::ShapeFilter& p_shape_filter = {}
+	) const override;
+
+	void CollideSoftBodyVertices(
+		JPH::Mat44Arg p_center_of_mass_transform,
+		JPH::Vec3Arg p_scale,
+		const JPH::CollideSoftBodyVertexIterator& p_vertices,
+		JPH::uint p_num_vertices,
+		int p_colliding_shape_index
+	) const override;
+
+	void CollectTransformedShapes(
+		const JPH::AABox& p_box,
+		JPH::Vec3Arg p_position_com,
+		JPH::QuatArg p_rotation,
+		JPH::Vec3Arg p_scale,
+		const JPH::SubShapeIDCreator& p_sub_shape_id_creator,
+		JPH::TransformedShapeCollector& p_collector,
+		const JPH::ShapeFilter& p_shape_filter = {}
+	) const override;
+
+	void TransformShape(
+		JPH::Mat44Arg p_center_of_mass_transform,
+		JPH::TransformedShapeCollector& p_collector
+	) const override;
+
+	void GetTrianglesStart(
+		GetTrianglesContext& p_context,
+		const JPH::AABox& p_box,
+		JPH::Vec3Arg p_position_com,
+		JPH::QuatArg p_rotation,
+		JPH::Vec3Arg p_scale
+	) const override;
+
+	float GetVolume() const override;
+
+	bool IsValidScale(JPH::Vec3Arg p_scale) const override {
+		return mInnerShape->IsValidScale(p_scale * scale);
+	}
+
+	JPH::Vec3 MakeScaleValid(JPH::Vec3Arg p_scale) const override {
+		return mInnerShape->MakeScaleValid(p_scale * scale) / scale;
+	}
+
+	JPH::Vec3 get_scale() const { return scale; }
+
+	JPH::Vec3 get_center_of_mass_offset() const { return center_of_mass_offset; }
+
+	bool should_collide_with_back_faces() const { return double_sided && back_face_collision; }
+
+	// Converts the scale passed to this shape into the scale to pass on to the inner shape.
+	JPH::Vec3 to_inner_scale(JPH::Vec3Arg p_scale) const { return p_scale * scale; }
+
+	// Converts a center-of-mass transform of this shape into that of the inner shape, where
+	// `p_inner_scale` is the scale returned by `to_inner_scale`.
+	JPH::Mat44 to_inner_transform(
+		JPH::Mat44Arg p_center_of_mass_transform,
+		JPH::Vec3Arg p_inner_scale
+	) const {
+		return p_center_of_mass_transform.PreTranslated(-p_inner_scale * center_of_mass_offset);
+	}
+
+	// Converts a position relative to the center of mass of this shape into one relative to that
+	// of the inner shape, where `p_inner_scale` is the scale returned by `to_inner_scale`.
+	JPH::Vec3 to_inner_position(
+		JPH::Vec3Arg p_position_com,
+		JPH::QuatArg p_rotation,
+		JPH::Vec3Arg p_inner_scale
+	) const {
+		return p_position_com - p_rotation * (p_inner_scale * center_of_mass_offset);
+	}
+
+	// Converts a point in the local space of this shape into the local space of the inner shape.
+	JPH::Vec3 to_inner_point(JPH::Vec3Arg p_point) const {
+		return p_point / scale + center_of_mass_offset;
+	}
+
+private:
+	JPH::Vec3 scale = JPH::Vec3::sReplicate(1.0f);
+
+	JPH::Vec3 center_of_mass_offset = JPH::Vec3::sZero();
+
+	bool override_user_data = false;
+
+	bool double_sided = false;
+
+	bool back_face_collision = false;
+};
@@ -1,6 +1,14 @@
 #include "jolt_height_map_shape_impl_3d.hpp"
 
 #include "servers/jolt_project_settings.hpp"
+#include "shapes/jolt_custom_shape_type.hpp"
+#include "shapes/jolt_shape_cache.hpp"
+
+namespace {
+
+constexpr int64_t EXPENSIVE_SAMPLE_COUNT = 65536;
+
+} // namespace
 
 Variant JoltHeightMapShapeImpl3D::get_data() const {
 	Dictionary data;
@@ -38,6 +46,72 @@ void JoltHeightMapShapeImpl3D::set_data(const Variant& p_data) {
 	destroy();
 }
 
+void JoltHeightMapShapeImpl3D::update_region(
+	const Rect2i& p_region,
+	const PackedFloat32Array& p_heights
+) {
+	ERR_FAIL_COND_MSG(
+		!p_region.has_area() || p_region.position.x < 0 || p_region.position.y < 0 ||
+			p_region.get_end().x > width || p_region.get_end().y > depth,
+		vformat(
+			"Failed to update region %s of height map shape with %s. "
+			"The region must lie within the bounds of the height map.",
+			p_region,
+			to_string()
+		)
+	);
+
+	ERR_FAIL_COND_MSG(
+		p_heights.size() != (int64_t)p_region.get_area(),
+		vformat(
+			"Failed to update region %s of height map shape with %s. "
+			"Expected %d heights but got %d.",
+			p_region,
+			to_string(),
+			p_region.get_area(),
+			p_heights.size()
+		)
+	);
+
+	// Any background cooking reads the heights we're about to change, so we wait for it.
+	cancel_cooking();
+
+	const int32_t quad_count_x = width - 1;
+	const int32_t quad_count_z = depth - 1;
+
+	const float offset_x = (float)-quad_count_x / 2.0f;
+	const float offset_z = (float)-quad_count_z / 2.0f;
+
+	const float* region_heights = p_heights.ptr();
+	real_t* heights_ptr = heights.ptrw();
+
+	for (int32_t z = p_region.position.y; z < p_region.get_end().y; ++z) {
+		for (int32_t x = p_region.position.x; x < p_region.get_end().x; ++x) {
+			const float height = *region_heights++;
+
+			heights_ptr[z * width + x] = (real_t)height;
+
+			// We only ever grow the AABB here, since shrinking it would mean going over every
+			// sample again, and a slightly too large AABB is harmless.
+			aabb.expand_to(Vector3(offset_x + (float)x, height, offset_z + (float)z));
+		}
+	}
+
+	// Shapes that are shared through interning can't be modified in place, so once a height map
+	// starts being deformed we give it a Jolt shape of its own, which we can then keep modifying.
+	deformable = true;
+
+	if (interned) {
+		destroy();
+	} else if (_try_update_height_field(p_region)) {
+		_notify_owners_modified_in_place();
+	} else if (_try_update_tiled_height_field(p_region)) {
+		_notify_owners();
+	} else {
+		destroy();
+	}
+}
+
 String JoltHeightMapShapeImpl3D::to_string() const {
 	return vformat("{height_count=%d width=%d depth=%d}", heights.size(), width, depth);
 }
@@ -69,11 +143,16 @@ JPH::ShapeRefC JoltHeightMapShapeImpl3D::_build() const {
 		)
 	);
 
+	const int32_t block_size = JoltProjectSettings::get_height_field_block_size();
+
+	if (const int32_t tile_size = _get_tile_size(); tile_size > 0) {
+		return JoltShapeImpl3D::with_double_sided(_build_tiled_height_field(tile_size), true);
+	}
+
 	if (width != depth) {
 		return JoltShapeImpl3D::with_double_sided(_build_mesh(), true);
 	}
 
-	const int32_t block_size = 2; // Default of JPH::HeightFieldShapeSettings::mBlockSize
 	const int32_t block_count = width / block_size;
 
 	if (block_count < 2) {
@@ -84,30 +163,94 @@ JPH::ShapeRefC JoltHeightMapShapeImpl3D::_build() const {
 }
 
 JPH::ShapeRefC JoltHeightMapShapeImpl3D::_build_height_field() const {
+	const JPH::ShapeRefC height_field = _build_height_field_tile(0, 0, width);
+	QUIET_FAIL_NULL_D(height_field);
+
+	return with_scale(height_field, Vector3(1, 1, -1));
+}
+
+JPH::ShapeRefC JoltHeightMapShapeImpl3D::_build_tiled_height_field(int32_t p_tile_size) const {
+	// Neighboring tiles share their edge samples, so each tile only covers this many new samples.
+	const int32_t tile_stride = p_tile_size - 1;
+	const int32_t tile_count_x = (width - 1 + tile_stride - 1) / tile_stride;
+	const int32_t tile_count_y = (depth - 1 + tile_stride - 1) / tile_stride;
+
+	JPH::StaticCompoundShapeSettings shape_settings;
+
+	for (int32_t tile_y = 0; tile_y < tile_count_y; ++tile_y) {
+		for (int32_t tile_x = 0; tile_x < tile_count_x; ++tile_x) {
+			const JPH::ShapeRefC tile = _build_height_field_tile(
+				tile_x * tile_stride,
+				tile_y * tile_stride,
+				p_tile_size
+			);
+
+			QUIET_FAIL_NULL_D(tile);
+
+			// We store the index of the tile with it, so that we can find it again when updating
+			// regions of the height map, since the compound shape is free to reorder its
+			// sub-shapes.
+			shape_settings.AddShape(
+				JPH::Vec3::sZero(),
+				JPH::Quat::sIdentity(),
+				tile,
+				(JPH::uint32)(tile_y * tile_count_x + tile_x)
+			);
+		}
+	}
+
+	const JPH::ShapeSettings::ShapeResult shape_result = shape_settings.Create();
+
+	ERR_FAIL_COND_D_MSG(
+		shape_result.HasError(),
+		vformat(
+			"Godot Jolt failed to build height map shape (as tiles) with %s. "
+			"It returned the following error: '%s'. "
+			"This shape belongs to %s.",
+			to_string(),
+			to_godot(shape_result.GetError()),
+			_owners_to_string()
+		)
+	);
+
+	return with_scale(shape_result.Get(), Vector3(1, 1, -1));
+}
+
+JPH::ShapeRefC JoltHeightMapShapeImpl3D::_build_height_field_tile(
+	int32_t p_x,
+	int32_t p_y,
+	int32_t p_sample_count
+) const {
 	const int32_t quad_count_x = width - 1;
 	const int32_t quad_count_y = depth - 1;
 
-	const float offset_x = (float)-quad_count_x / 2.0f;
-	const float offset_y = (float)-quad_count_y / 2.0f;
+	const float offset_x = (float)-quad_count_x / 2.0f + (float)p_x;
+	const float offset_y = (float)-quad_count_y / 2.0f + (float)p_y;
 
 	// HACK(mihe): Jolt triangulates the height map differently from how Godot Physics does it, so
 	// we mirror the shape along the Z-axis to get the desired triangulation and reverse the rows to
 	// undo the mirroring.
 
-	LocalVector<float> heights_rev;
-	heights_rev.resize((int32_t)heights.size());
+	PackedFloat32Array heights_rev;
+	heights_rev.resize(p_sample_count * p_sample_count);
 
 	const real_t* heights_ptr = heights.ptr();
-	float* heights_rev_ptr = heights_rev.ptr();
+	float* heights_rev_ptr = heights_rev.ptrw();
 
-	for (int32_t z = 0; z < depth; ++z) {
-		const int32_t z_rev = (depth - 1) - z;
+	for (int32_t y = 0; y < p_sample_count; ++y) {
+		const int32_t z = (depth - 1) - (p_y + y);
 
-		const real_t* row = heights_ptr + ptrdiff_t(z * width);
-		float* row_rev = heights_rev_ptr + ptrdiff_t(z_rev * width);
+		float* row_rev = heights_rev_ptr + ptrdiff_t(y * p_sample_count);
 
-		for (int32_t x = 0; x < width; ++x) {
-			const real_t height = row[x];
+		for (int32_t x = 0; x < p_sample_count; ++x) {
+			// Tiles along the edges can reach past the end of the height map, in which case we fill
+			// the remainder of the tile with holes.
+			if (z < 0 || p_x + x >= width) {
+				row_rev[x] = FLT_MAX;
+				continue;
+			}
+
+			const real_t height = heights_ptr[z * width + p_x + x];
 
 			// HACK(mihe): Godot has undocumented (accidental?) support for holes by passing NaN as
 			// the height value, whereas Jolt uses `FLT_MAX` instead, so we translate any NaN to
@@ -116,15 +259,41 @@ JPH::ShapeRefC JoltHeightMapShapeImpl3D::_build_height_field() const {
 		}
 	}
 
+	const float active_edge_threshold = JoltProjectSettings::get_active_edge_threshold();
+	const float max_error = JoltProjectSettings::get_height_field_max_error();
+	const int32_t block_size = JoltProjectSettings::get_height_field_block_size();
+
+	String cache_path;
+
+	// Deformable height maps are modified too often for caching them to be worth it.
+	if (!deformable) {
+		Array cache_inputs;
+		cache_inputs.append((int32_t)get_type());
+		cache_inputs.append(heights_rev);
+		cache_inputs.append(p_sample_count);
+		cache_inputs.append(offset_x);
+		cache_inputs.append(offset_y);
+		cache_inputs.append(active_edge_threshold);
+		cache_inputs.append(max_error);
+		cache_inputs.append(block_size);
+
+		cache_path = JoltShapeCache::make_path(cache_inputs);
+	}
+
+	if (const JPH::ShapeRefC cached_shape = JoltShapeCache::load(cache_path)) {
+		return cached_shape;
+	}
+
 	JPH::HeightFieldShapeSettings shape_settings(
 		heights_rev.ptr(),
 		JPH::Vec3(offset_x, 0, offset_y),
 		JPH::Vec3::sOne(),
-		(JPH::uint32)width
+		(JPH::uint32)p_sample_count
 	);
 
-	shape_settings.mBitsPerSample = shape_settings.CalculateBitsPerSampleForError(0.0f);
-	shape_settings.mActiveEdgeCosThresholdAngle = JoltProjectSettings::get_active_edge_threshold();
+	shape_settings.mBlockSize = (JPH::uint32)block_size;
+	shape_settings.mBitsPerSample = shape_settings.CalculateBitsPerSampleForError(max_error);
+	shape_settings.mActiveEdgeCosThresholdAngle = active_edge_threshold;
 
 	const JPH::ShapeSettings::ShapeResult shape_result = shape_settings.Create();
 
@@ -140,10 +309,18 @@ JPH::ShapeRefC JoltHeightMapShapeImpl3D::_build_height_field() const {
 		)
 	);
 
-	return with_scale(shape_result.Get(), Vector3(1, 1, -1));
+	JoltShapeCache::save(cache_path, shape_result.Get());
+
+	return shape_result.Get();
 }
 
 JPH::ShapeRefC JoltHeightMapShapeImpl3D::_build_mesh() const {
+	const String cache_path = _make_cache_path();
+
+	if (const JPH::ShapeRefC cached_shape = JoltShapeCache::load(cache_path)) {
+		return cached_shape;
+	}
+
 	const auto height_count = (int32_t)heights.size();
 
 	const int32_t quad_count_x = width - 1;
@@ -218,9 +395,228 @@ JPH::ShapeRefC JoltHeightMapShapeImpl3D::_build_mesh() const {
 		)
 	);
 
+	JoltShapeCache::save(cache_path, shape_result.Get());
+
 	return shape_result.Get();
 }
 
+bool JoltHeightMapShapeImpl3D::_try_update_height_field(const Rect2i& p_region) {
+	QUIET_FAIL_NULL_D(jolt_ref);
+	QUIET_FAIL_COND_D(jolt_ref->GetSubType() != JoltCustomShapeSubType::DOUBLE_SIDED);
+
+	const auto* double_sided_shape = static_cast<const JPH::DecoratedShape*>(jolt_ref.GetPtr());
+	const JPH::Shape* inner_shape = double_sided_shape->GetInnerShape();
+	QUIET_FAIL_COND_D(inner_shape->GetSubType() != JPH::EShapeSubType::Scaled);
+
+	const auto* scaled_shape = static_cast<const JPH::ScaledShape*>(inner_shape);
+	inner_shape = scaled_shape->GetInnerShape();
+	QUIET_FAIL_COND_D(inner_shape->GetSubType() != JPH::EShapeSubType::HeightField);
+
+	return _try_update_height_field_tile(inner_shape, Rect2i(0, 0, width, depth), p_region);
+}
+
+bool JoltHeightMapShapeImpl3D::_try_update_tiled_height_field(const Rect2i& p_region) {
+	QUIET_FAIL_NULL_D(jolt_ref);
+	QUIET_FAIL_COND_D(jolt_ref->GetSubType() != JoltCustomShapeSubType::DOUBLE_SIDED);
+
+	const auto* double_sided_shape = static_cast<const JPH::DecoratedShape*>(jolt_ref.GetPtr());
+	const JPH::Shape* inner_shape = double_sided_shape->GetInnerShape();
+	QUIET_FAIL_COND_D(inner_shape->GetSubType() != JPH::EShapeSubType::Scaled);
+
+	const auto* scaled_shape = static_cast<const JPH::ScaledShape*>(inner_shape);
+	inner_shape = scaled_shape->GetInnerShape();
+	QUIET_FAIL_COND_D(inner_shape->GetSubType() != JPH::EShapeSubType::StaticCompound);
+
+	const auto* compound_shape = static_cast<const JPH::StaticCompoundShape*>(inner_shape);
+
+	const int32_t tile_size = _get_tile_size();
+	QUIET_FAIL_COND_D(tile_size == 0);
+
+	const int32_t tile_stride = tile_size - 1;
+	const int32_t tile_count_x = (width - 1 + tile_stride - 1) / tile_stride;
+
+	// The tiles are laid out with their rows reversed, as explained in `_build_height_field_tile`.
+	const Rect2i region_rev(
+		p_region.position.x,
+		depth - p_region.get_end().y,
+		p_region.size.x,
+		p_region.size.y
+	);
+
+	JPH::StaticCompoundShapeSettings shape_settings;
+
+	for (JPH::uint i = 0; i < compound_shape->GetNumSubShapes(); ++i) {
+		const JPH::CompoundShape::SubShape& sub_shape = compound_shape->GetSubShape(i);
+
+		// The compound shape is free to reorder its sub-shapes, so we rely on the index that we
+		// stored in the user data when building it, rather than the index of the sub-shape.
+		const auto tile_index = (int32_t)sub_shape.mUserData;
+		const int32_t tile_x = tile_index % tile_count_x;
+		const int32_t tile_y = tile_index / tile_count_x;
+
+		const Rect2i tile_rect(tile_x * tile_stride, tile_y * tile_stride, tile_size, tile_size);
+
+		JPH::ShapeRefC tile = sub_shape.mShape;
+
+		// Tiles that can't be updated in place are rebuilt, which is still a lot cheaper than
+		// rebuilding every tile of the height map.
+		if (tile_rect.intersects(region_rev) &&
+			!_try_update_height_field_tile(tile, tile_rect, p_region)) {
+			tile = _build_height_field_tile(tile_rect.position.x, tile_rect.position.y, tile_size);
+			QUIET_FAIL_NULL_D(tile);
+		}
+
+		shape_settings.AddShape(
+			JPH::Vec3::sZero(),
+			JPH::Quat::sIdentity(),
+			tile,
+			(JPH::uint32)tile_index
+		);
+	}
+
+	// The compound shape holds on to the bounds of its tiles, which might have changed, so we need
+	// a new one, but since it references the same tiles this is cheap compared to building them.
+	const JPH::ShapeSettings::ShapeResult shape_result = shape_settings.Create();
+	QUIET_FAIL_COND_D(shape_result.HasError());
+
+	const JPH::ShapeRefC scaled_compound = with_scale(shape_result.Get(), Vector3(1, 1, -1));
+	QUIET_FAIL_NULL_D(scaled_compound);
+
+	jolt_ref = JoltShapeImpl3D::with_double_sided(scaled_compound, true);
+
+	return jolt_ref != nullptr;
+}
+
+bool JoltHeightMapShapeImpl3D::_try_update_height_field_tile(
+	const JPH::Shape* p_tile,
+	const Rect2i& p_tile_rect,
+	const Rect2i& p_region
+) {
+	QUIET_FAIL_COND_D(p_tile->GetSubType() != JPH::EShapeSubType::HeightField);
+
+	// This shape is not interned, so nothing but this shape resource (and the objects using it)
+	// holds on to it, which means we can safely modify it in place.
+	auto* height_field = const_cast<JPH::HeightFieldShape*>(
+		static_cast<const JPH::HeightFieldShape*>(p_tile)
+	);
+
+	const auto block_size = (int32_t)height_field->GetBlockSize();
+
+	// The height field is mirrored along the Z-axis, as explained in `_build_height_field_tile`,
+	// and Jolt can only update whole blocks, so we need to grow the region accordingly.
+	const int32_t tile_x = p_tile_rect.position.x;
+	const int32_t tile_y = p_tile_rect.position.y;
+	const int32_t z_rev_begin = depth - p_region.get_end().y;
+	const int32_t z_rev_end = depth - p_region.position.y;
+
+	const int32_t x_rel_begin = MAX(p_region.position.x - tile_x, 0);
+	const int32_t y_rel_begin = MAX(z_rev_begin - tile_y, 0);
+	const int32_t x_rel_end = MIN(p_region.get_end().x - tile_x, p_tile_rect.size.x);
+	const int32_t y_rel_end = MIN(z_rev_end - tile_y, p_tile_rect.size.y);
+
+	const int32_t x_begin = (x_rel_begin / block_size) * block_size;
+	const int32_t y_begin = (y_rel_begin / block_size) * block_size;
+	const int32_t x_end = ((x_rel_end + block_size - 1) / block_size) * block_size;
+	const int32_t y_end = ((y_rel_end + block_size - 1) / block_size) * block_size;
+
+	// Jolt pads the height field to a multiple of the block size, and we don't have heights for any
+	// such padding, so regions that reach into it are left to a rebuild instead.
+	QUIET_FAIL_COND_D(x_end > p_tile_rect.size.x || y_end > p_tile_rect.size.y);
+
+	const int32_t size_x = x_end - x_begin;
+	const int32_t size_y = y_end - y_begin;
+
+	const float min_height = height_field->GetMinHeightValue();
+	const float max_height = height_field->GetMaxHeightValue();
+
+	LocalVector<float> heights_rev;
+	heights_rev.reserve(size_x * size_y);
+
+	for (int32_t y = y_begin; y < y_end; ++y) {
+		const int32_t z = (depth - 1) - (tile_y + y);
+
+		for (int32_t x = x_begin; x < x_end; ++x) {
+			const int32_t map_x = tile_x + x;
+
+			// Tiles along the edges can reach past the end of the height map, which is filled with
+			// holes, same as when building the tile.
+			if (z < 0 || map_x >= width) {
+				heights_rev.push_back(FLT_MAX);
+				continue;
+			}
+
+			const real_t height = heights[z * width + map_x];
+
+			if (Math::is_nan(height)) {
+				heights_rev.push_back(FLT_MAX);
+				continue;
+			}
+
+			// Heights outside of the range that the height field was quantized for would get
+			// clamped, so we leave those to a rebuild as well.
+			QUIET_FAIL_COND_D(height < min_height || height > max_height);
+
+			heights_rev.push_back((float)height);
+		}
+	}
+
+	JPH::TempAllocatorMalloc temp_allocator;
+
+	height_field->SetHeights(
+		(JPH::uint)x_begin,
+		(JPH::uint)y_begin,
+		(JPH::uint)size_x,
+		(JPH::uint)size_y,
+		heights_rev.ptr(),
+		size_x,
+		temp_allocator,
+		JoltProjectSettings::get_active_edge_threshold()
+	);
+
+	return true;
+}
+
+int32_t JoltHeightMapShapeImpl3D::_get_tile_size() const {
+	const int32_t tile_size = JoltProjectSettings::get_height_map_tile_size();
+
+	if (tile_size <= 0 || (width <= tile_size && depth <= tile_size)) {
+		return 0;
+	}
+
+	// Anything smaller than this would end up with fewer than 2 blocks per tile.
+	const int32_t min_tile_size = JoltProjectSettings::get_height_field_block_size() * 2;
+
+	return MAX(tile_size, min_tile_size);
+}
+
+String JoltHeightMapShapeImpl3D::_make_cache_path() const {
+	// Deformable height maps are modified too often for caching them to be worth it.
+	QUIET_FAIL_COND_D(deformable);
+
+	Array cache_inputs;
+	cache_inputs.append((int32_t)get_type());
+	cache_inputs.append(heights);
+	cache_inputs.append(width);
+	cache_inputs.append(depth);
+	cache_inputs.append(JoltProjectSettings::get_active_edge_threshold());
+
+	return JoltShapeCache::make_path(cache_inputs);
+}
+
+bool JoltHeightMapShapeImpl3D::_is_expensive_to_build() const {
+	return (int64_t)width * (int64_t)depth >= EXPENSIVE_SAMPLE_COUNT;
+}
+
+void JoltHeightMapShapeImpl3D::_hash_intern_data(const Ref<HashingContext>& p_context) const {
+	PackedByteArray dimensions;
+	dimensions.resize(8);
+	dimensions.encode_s32(0, width);
+	dimensions.encode_s32(4, depth);
+
+	p_context->update(dimensions);
+	p_context->update(heights.to_byte_array());
+}
+
 AABB JoltHeightMapShapeImpl3D::_calculate_aabb() const {
 	AABB result;
 
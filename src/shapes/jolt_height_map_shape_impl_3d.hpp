@@ -18,15 +18,41 @@ public:
 
 	AABB get_aabb() const override { return aabb; }
 
+	void update_region(const Rect2i& p_region, const PackedFloat32Array& p_heights);
+
 	String to_string() const;
 
 private:
 	JPH::ShapeRefC _build() const override;
 
+	bool _can_be_interned() const override { return !deformable; }
+
+	void _hash_intern_data(const Ref<HashingContext>& p_context) const override;
+
+	bool _try_update_height_field(const Rect2i& p_region);
+
+	bool _try_update_tiled_height_field(const Rect2i& p_region);
+
+	bool _try_update_height_field_tile(
+		const JPH::Shape* p_tile,
+		const Rect2i& p_tile_rect,
+		const Rect2i& p_region
+	);
+
+	int32_t _get_tile_size() const;
+
 	JPH::ShapeRefC _build_height_field() const;
 
+	JPH::ShapeRefC _build_tiled_height_field(int32_t p_tile_size) const;
+
+	JPH::ShapeRefC _build_height_field_tile(int32_t p_x, int32_t p_y, int32_t p_sample_count) const;
+
 	JPH::ShapeRefC _build_mesh() const;
 
+	String _make_cache_path() const;
+
+	bool _is_expensive_to_build() const override;
+
 	AABB _calculate_aabb() const;
 
 	AABB aabb;
@@ -40,4 +66,6 @@ private:
 	int32_t width = 0;
 
 	int32_t depth = 0;
+
+	bool deformable = false;
 };
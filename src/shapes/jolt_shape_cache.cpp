@@ -0,0 +1,197 @@
+#include "jolt_shape_cache.hpp"
+
+#include "servers/jolt_project_settings.hpp"
+
+namespace {
+
+// Needs to be bumped whenever the way we cook any of the cached shapes changes, or the layout of
+// the cache files themselves changes.
+constexpr int32_t FORMAT_VERSION = 3;
+
+// "GDJS" in little-endian.
+constexpr uint32_t HEADER_MAGIC = 0x534A4447;
+
+constexpr int64_t CHECKSUM_SIZE = 32;
+
+// Magic, format version, data size and checksum.
+constexpr int64_t HEADER_SIZE = 4 + 4 + 8 + CHECKSUM_SIZE;
+
+// Jolt makes no guarantees about its binary format staying the same across commits, precision or
+// platforms, so anything that might affect it needs to go into the cache key as well.
+
+#ifdef JPH_DOUBLE_PRECISION
+constexpr char PRECISION_NAME[] = "double";
+#else // JPH_DOUBLE_PRECISION
+constexpr char PRECISION_NAME[] = "single";
+#endif // JPH_DOUBLE_PRECISION
+
+#if defined(GDJ_PLATFORM_WINDOWS)
+constexpr char PLATFORM_NAME[] = "windows";
+#elif defined(GDJ_PLATFORM_LINUX)
+constexpr char PLATFORM_NAME[] = "linux";
+#elif defined(GDJ_PLATFORM_MACOS)
+constexpr char PLATFORM_NAME[] = "macos";
+#elif defined(GDJ_PLATFORM_IOS)
+constexpr char PLATFORM_NAME[] = "ios";
+#elif defined(GDJ_PLATFORM_ANDROID)
+constexpr char PLATFORM_NAME[] = "android";
+#else
+constexpr char PLATFORM_NAME[] = "unknown";
+#endif
+
+#if defined(JPH_CPU_X86)
+constexpr char ARCHITECTURE_NAME[] = "x86";
+#elif defined(JPH_CPU_ARM)
+constexpr char ARCHITECTURE_NAME[] = "arm";
+#else
+constexpr char ARCHITECTURE_NAME[] = "unknown";
+#endif
+
+class JoltByteStreamOut final : public JPH::StreamOut {
+public:
+	void WriteBytes(const void* p_data, size_t p_bytes) override {
+		const int64_t offset = data.size();
+		data.resize(offset + (int64_t)p_bytes);
+		memcpy(data.ptrw() + offset, p_data, p_bytes);
+	}
+
+	bool IsFailed() const override { return false; }
+
+	const PackedByteArray& get_data() const { return data; }
+
+private:
+	PackedByteArray data;
+};
+
+class JoltByteStreamIn final : public JPH::StreamIn {
+public:
+	explicit JoltByteStreamIn(const PackedByteArray& p_data)
+		: data(p_data) { }
+
+	void ReadBytes(void* p_data, size_t p_bytes) override {
+		if (failed || offset + (int64_t)p_bytes > data.size()) {
+			memset(p_data, 0, p_bytes);
+			failed = true;
+			return;
+		}
+
+		memcpy(p_data, data.ptr() + offset, p_bytes);
+		offset += (int64_t)p_bytes;
+	}
+
+	bool IsEOF() const override { return offset >= data.size(); }
+
+	bool IsFailed() const override { return failed; }
+
+private:
+	const PackedByteArray& data;
+
+	int64_t offset = 0;
+
+	bool failed = false;
+};
+
+PackedByteArray calculate_sha256(const PackedByteArray& p_data) {
+	Ref<HashingContext> hashing_context;
+	hashing_context.instantiate();
+	hashing_context->start(HashingContext::HASH_SHA256);
+	hashing_context->update(p_data);
+
+	return hashing_context->finish();
+}
+
+} // namespace
+
+String JoltShapeCache::make_path(const Array& p_inputs) {
+	QUIET_FAIL_COND_D(!JoltProjectSettings::use_shape_cache());
+
+	Array versioned_inputs;
+	versioned_inputs.append(FORMAT_VERSION);
+	versioned_inputs.append(GDJ_JOLT_COMMIT);
+	versioned_inputs.append(PRECISION_NAME);
+	versioned_inputs.append(PLATFORM_NAME);
+	versioned_inputs.append(ARCHITECTURE_NAME);
+	versioned_inputs.append(JPH_CPU_ADDRESS_BITS);
+	versioned_inputs.append_array(p_inputs);
+
+	const PackedByteArray hash = calculate_sha256(UtilityFunctions::var_to_bytes(versioned_inputs));
+
+	return JoltProjectSettings::get_shape_cache_directory().path_join(hash.hex_encode() + ".bin");
+}
+
+JPH::ShapeRefC JoltShapeCache::load(const String& p_path) {
+	QUIET_FAIL_COND_D(p_path.is_empty());
+	QUIET_FAIL_COND_D(!FileAccess::file_exists(p_path));
+
+	const Ref<FileAccess> file_access = FileAccess::open(p_path, FileAccess::ModeFlags::READ);
+	QUIET_FAIL_NULL_D(file_access);
+
+	// Jolt does very little validation of what it restores, so a truncated or otherwise corrupt
+	// file could easily bring it down, which is why we verify the file before handing it over. Any
+	// file that fails this is simply cooked again and overwritten.
+
+	const auto file_size = (int64_t)file_access->get_length();
+	QUIET_FAIL_COND_D(file_size < HEADER_SIZE);
+
+	QUIET_FAIL_COND_D(file_access->get_32() != HEADER_MAGIC);
+	QUIET_FAIL_COND_D(file_access->get_32() != (uint32_t)FORMAT_VERSION);
+
+	const auto data_size = (int64_t)file_access->get_64();
+	QUIET_FAIL_COND_D(data_size != file_size - HEADER_SIZE);
+
+	const PackedByteArray checksum = file_access->get_buffer(CHECKSUM_SIZE);
+	const PackedByteArray data = file_access->get_buffer(data_size);
+
+	QUIET_FAIL_COND_D(file_access->get_error() != OK);
+	QUIET_FAIL_COND_D(data.size() != data_size);
+	QUIET_FAIL_COND_D(calculate_sha256(data) != checksum);
+
+	JoltByteStreamIn input_stream(data);
+	const JPH::Shape::ShapeResult shape_result = JPH::Shape::sRestoreFromBinaryState(input_stream);
+
+	QUIET_FAIL_COND_D(shape_result.HasError() || input_stream.IsFailed());
+
+	return shape_result.Get();
+}
+
+void JoltShapeCache::save(const String& p_path, const JPH::Shape* p_shape) {
+	QUIET_FAIL_COND(p_path.is_empty());
+	QUIET_FAIL_NULL(p_shape);
+
+	JoltByteStreamOut output_stream;
+	p_shape->SaveBinaryState(output_stream);
+
+	const PackedByteArray& data = output_stream.get_data();
+
+	DirAccess::make_dir_recursive_absolute(p_path.get_base_dir());
+
+	// We write to a temporary file first and then move it into place, so that other threads or
+	// processes never end up reading a partially written file.
+	const String temp_path = vformat(
+		"%s.%d-%d.tmp",
+		p_path,
+		OS::get_singleton()->get_process_id(),
+		OS::get_singleton()->get_thread_caller_id()
+	);
+
+	Ref<FileAccess> file_access = FileAccess::open(temp_path, FileAccess::ModeFlags::WRITE);
+
+	ERR_FAIL_NULL_MSG(
+		file_access,
+		vformat("Failed to open '%s' for writing when saving cooked shape to cache.", temp_path)
+	);
+
+	file_access->store_32(HEADER_MAGIC);
+	file_access->store_32((uint32_t)FORMAT_VERSION);
+	file_access->store_64((uint64_t)data.size());
+	file_access->store_buffer(calculate_sha256(data));
+	file_access->store_buffer(data);
+
+	const Error error = file_access->get_error();
+
+	file_access->close();
+
+	if (error != OK || DirAccess::rename_absolute(temp_path, p_path) != OK) {
+		DirAccess::remove_absolute(temp_path);
+	}
+}
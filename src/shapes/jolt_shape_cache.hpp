@@ -0,0 +1,14 @@
+#pragma once
+
+// Stores cooked Jolt shapes on disk, keyed on a hash of everything that went into cooking them, so
+// that subsequent launches can restore them instead of cooking them all over again.
+class JoltShapeCache {
+public:
+	// Returns the path of the cache file for the given inputs, or an empty string if the cache is
+	// disabled, in which case `load` and `save` do nothing.
+	static String make_path(const Array& p_inputs);
+
+	static JPH::ShapeRefC load(const String& p_path);
+
+	static void save(const String& p_path, const JPH::Shape* p_shape);
+};
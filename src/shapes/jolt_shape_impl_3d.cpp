@@ -1,16 +1,41 @@
 #include "jolt_shape_impl_3d.hpp"
 
+#include "objects/jolt_character_impl_3d.hpp"
 #include "objects/jolt_shaped_object_impl_3d.hpp"
+#include "servers/jolt_project_settings.hpp"
+#include "spaces/jolt_query_impl_3d.hpp"
 #include "shapes/jolt_custom_double_sided_shape.hpp"
+#include "shapes/jolt_custom_fused_shape.hpp"
 #include "shapes/jolt_custom_user_data_shape.hpp"
 
 namespace {
 
 constexpr float DEFAULT_SOLVER_BIAS = 0.0;
 
+JPH::ShapeRefC create_fused_shape(const JoltCustomFusedShapeSettings& p_settings) {
+	const JPH::ShapeSettings::ShapeResult shape_result = p_settings.Create();
+
+	ERR_FAIL_COND_D_MSG(
+		shape_result.HasError(),
+		vformat(
+			"Failed to decorate shape with {scale=%v center_of_mass_offset=%v}. "
+			"It returned the following error: '%s'.",
+			to_godot(p_settings.scale),
+			to_godot(p_settings.center_of_mass_offset),
+			to_godot(shape_result.GetError())
+		)
+	);
+
+	return shape_result.Get();
+}
+
 } // namespace
 
-JoltShapeImpl3D::~JoltShapeImpl3D() = default;
+JoltShapeImpl3D::~JoltShapeImpl3D() {
+	// Any background cooking must have been cancelled before getting here, since the data it reads
+	// belongs to the derived class, which has already been destroyed at this point.
+	_release_jolt_ref();
+}
 
 void JoltShapeImpl3D::add_owner(JoltShapedObjectImpl3D* p_owner) {
 	ref_counts_by_owner[p_owner]++;
@@ -22,6 +47,26 @@ void JoltShapeImpl3D::remove_owner(JoltShapedObjectImpl3D* p_owner) {
 	}
 }
 
+void JoltShapeImpl3D::add_character(JoltCharacterImpl3D* p_character) {
+	characters.insert(p_character);
+}
+
+void JoltShapeImpl3D::remove_character(JoltCharacterImpl3D* p_character) {
+	characters.erase(p_character);
+}
+
+void JoltShapeImpl3D::add_query(JoltQueryImpl3D* p_query) {
+	const std::unique_lock<std::mutex> queries_lock(queries_mutex);
+
+	queries.insert(p_query);
+}
+
+void JoltShapeImpl3D::remove_query(JoltQueryImpl3D* p_query) {
+	const std::unique_lock<std::mutex> queries_lock(queries_mutex);
+
+	queries.erase(p_query);
+}
+
 void JoltShapeImpl3D::remove_self() {
 	// `remove_owner` will be called when we `remove_shape`, so we need to copy the map since the
 	// iterator would be invalidated from underneath us
@@ -30,6 +75,24 @@ void JoltShapeImpl3D::remove_self() {
 	for (const auto& [owner, ref_count] : ref_counts_by_owner_copy) {
 		owner->remove_shape(this);
 	}
+
+	// Same goes for `remove_character`, which will be called when we clear the character's shape.
+	const auto characters_copy = characters;
+
+	for (JoltCharacterImpl3D* character : characters_copy) {
+		character->set_shape(nullptr);
+	}
+
+	HashSet<JoltQueryImpl3D*> queries_copy;
+
+	{
+		const std::unique_lock<std::mutex> queries_lock(queries_mutex);
+		queries_copy = queries;
+	}
+
+	for (JoltQueryImpl3D* query : queries_copy) {
+		query->set_shape(nullptr);
+	}
 }
 
 float JoltShapeImpl3D::get_solver_bias() const {
@@ -48,19 +111,112 @@ void JoltShapeImpl3D::set_solver_bias(float p_bias) {
 }
 
 JPH::ShapeRefC JoltShapeImpl3D::try_build() {
-	if (jolt_ref == nullptr) {
-		jolt_ref = _build();
+	const MutexLock lock(build_mutex);
+
+	if (is_cooking()) {
+		_finish_cooking();
+		return jolt_ref;
+	}
+
+	if (jolt_ref != nullptr || _try_find_interned()) {
+		return jolt_ref;
 	}
 
+	_set_built_jolt_ref(_build());
+
 	return jolt_ref;
 }
 
+JPH::ShapeRefC JoltShapeImpl3D::try_build_in_background() {
+	const MutexLock lock(build_mutex);
+
+	if (is_cooking() || cooking_failed) {
+		return {};
+	}
+
+	if (!JoltProjectSettings::use_background_shape_cooking() || !_is_expensive_to_build()) {
+		return try_build();
+	}
+
+	if (jolt_ref != nullptr || _try_find_interned()) {
+		return jolt_ref;
+	}
+
+	// The cooking thread can't be allowed to touch our owners, since those are modified from the
+	// main thread, so we give it a snapshot of what it might need from them for error messages.
+	cook_owners_string = _owners_to_string();
+
+	cook_task_id = WorkerThreadPool::get_singleton()->add_native_task(
+		&_cook,
+		this,
+		false,
+		"JoltShapeCooking"
+	);
+
+	const std::unique_lock<std::mutex> cooking_lock(cooking_shapes_mutex);
+	cooking_shapes.insert(this);
+
+	return {};
+}
+
+void JoltShapeImpl3D::cancel_cooking() {
+	const MutexLock lock(build_mutex);
+
+	if (is_cooking()) {
+		_finish_cooking();
+		_release_jolt_ref();
+	}
+
+	const std::unique_lock<std::mutex> cooking_lock(cooking_shapes_mutex);
+	cooking_shapes.erase(this);
+}
+
+void JoltShapeImpl3D::finish_cooked_shapes() {
+	// We copy the set of shapes, since the owners rebuilding their shapes might end up queueing
+	// more shapes for cooking, which would invalidate the iterator.
+	LocalVector<JoltShapeImpl3D*> cooking_shapes_copy;
+
+	{
+		const std::unique_lock<std::mutex> cooking_lock(cooking_shapes_mutex);
+
+		for (JoltShapeImpl3D* shape : cooking_shapes) {
+			cooking_shapes_copy.push_back(shape);
+		}
+	}
+
+	for (JoltShapeImpl3D* shape : cooking_shapes_copy) {
+		{
+			const MutexLock lock(shape->build_mutex);
+
+			// A query might have already finished the cooking for us, in which case the shape is
+			// left in the set so that we still get to notify its owners here.
+			if (shape->is_cooking()) {
+				if (!WorkerThreadPool::get_singleton()->is_task_completed(shape->cook_task_id)) {
+					continue;
+				}
+
+				shape->_finish_cooking();
+			}
+
+			const std::unique_lock<std::mutex> cooking_lock(cooking_shapes_mutex);
+			cooking_shapes.erase(shape);
+		}
+
+		shape->_notify_owners();
+	}
+}
+
 void JoltShapeImpl3D::destroy() {
-	jolt_ref = nullptr;
+	{
+		const MutexLock lock(build_mutex);
 
-	for (const auto& [owner, ref_count] : ref_counts_by_owner) {
-		owner->_shapes_changed();
+		cancel_cooking();
+		_release_jolt_ref();
+
+		cooking_failed = false;
 	}
+
+	_notify_owners();
 }
 
 JPH::ShapeRefC JoltShapeImpl3D::with_scale(const JPH::Shape* p_shape, const Vector3& p_scale) {
@@ -188,6 +344,38 @@ JPH::ShapeRefC JoltShapeImpl3D::with_double_sided(
 	return shape_result.Get();
 }
 
+JPH::ShapeRefC JoltShapeImpl3D::with_user_data_and_scale(
+	const JPH::Shape* p_shape,
+	uint64_t p_user_data,
+	const Vector3& p_scale
+) {
+	ERR_FAIL_NULL_D(p_shape);
+
+	JoltCustomFusedShapeSettings shape_settings(p_shape);
+	shape_settings.mUserData = (JPH::uint64)p_user_data;
+	shape_settings.override_user_data = true;
+	shape_settings.scale = to_jolt(p_scale);
+
+	return create_fused_shape(shape_settings);
+}
+
+JPH::ShapeRefC JoltShapeImpl3D::with_decorations(
+	const JPH::Shape* p_shape,
+	const Vector3& p_scale,
+	const Vector3& p_center_of_mass_offset,
+	bool p_double_sided
+) {
+	ERR_FAIL_NULL_D(p_shape);
+
+	JoltCustomFusedShapeSettings shape_settings(p_shape);
+	shape_settings.scale = to_jolt(p_scale);
+	shape_settings.center_of_mass_offset = to_jolt(p_center_of_mass_offset);
+	shape_settings.double_sided = p_double_sided;
+	shape_settings.back_face_collision = p_double_sided;
+
+	return create_fused_shape(shape_settings);
+}
+
 JPH::ShapeRefC JoltShapeImpl3D::without_custom_shapes(const JPH::Shape* p_shape) {
 	switch (p_shape->GetSubType()) {
 		case JoltCustomShapeSubType::RAY:
@@ -204,6 +392,27 @@ JPH::ShapeRefC JoltShapeImpl3D::without_custom_shapes(const JPH::Shape* p_shape)
 			return without_custom_shapes(shape->GetInnerShape());
 		}
 
+		case JoltCustomShapeSubType::FUSED: {
+			const auto* shape = static_cast<const JoltCustomFusedShape*>(p_shape);
+
+			// Replace the fused decorator shape with the supported decorator shapes that it's made
+			// up of, minus the ones that are themselves unsupported.
+			JPH::ShapeRefC new_shape = without_custom_shapes(shape->GetInnerShape());
+
+			if (shape->get_center_of_mass_offset() != JPH::Vec3::sZero()) {
+				new_shape = new JPH::OffsetCenterOfMassShape(
+					new_shape,
+					shape->get_center_of_mass_offset()
+				);
+			}
+
+			if (shape->get_scale() != JPH::Vec3::sReplicate(1.0f)) {
+				new_shape = new JPH::ScaledShape(new_shape, shape->get_scale());
+			}
+
+			return new_shape;
+		}
+
 		case JPH::EShapeSubType::StaticCompound: {
 			const auto* shape = static_cast<const JPH::StaticCompoundShape*>(p_shape);
 
@@ -324,6 +533,10 @@ bool JoltShapeImpl3D::is_scale_valid(
 }
 
 String JoltShapeImpl3D::_owners_to_string() const {
+	if (!cook_owners_string.is_empty()) {
+		return cook_owners_string;
+	}
+
 	const int32_t owner_count = ref_counts_by_owner.size();
 
 	if (owner_count == 0) {
@@ -334,3 +547,81 @@ String JoltShapeImpl3D::_owners_to_string() const {
 
 	return vformat("'%s' and %d other object(s)", random_owner.to_string(), owner_count - 1);
 }
+
+void JoltShapeImpl3D::_notify_owners() {
+	for (const auto& [owner, ref_count] : ref_counts_by_owner) {
+		owner->_shapes_changed();
+	}
+
+	for (JoltCharacterImpl3D* character : characters) {
+		character->_shape_changed();
+	}
+
+	const std::unique_lock<std::mutex> queries_lock(queries_mutex);
+
+	for (JoltQueryImpl3D* query : queries) {
+		query->_shape_changed();
+	}
+}
+
+void JoltShapeImpl3D::_notify_owners_modified_in_place() {
+	for (const auto& [owner, ref_count] : ref_counts_by_owner) {
+		owner->_shape_modified_in_place();
+	}
+}
+
+bool JoltShapeImpl3D::_try_find_interned() {
+	if (!JoltProjectSettings::use_shape_interning() || !_can_be_interned()) {
+		return false;
+	}
+
+	Ref<HashingContext> hashing_context;
+	hashing_context.instantiate();
+	hashing_context->start(HashingContext::HASH_SHA256);
+
+	_hash_intern_data(hashing_context);
+
+	intern_key = JoltShapeInterner::make_key(get_type(), hashing_context->finish(), get_margin());
+	interned = true;
+
+	jolt_ref = JoltShapeInterner::find(intern_key);
+
+	return jolt_ref != nullptr;
+}
+
+void JoltShapeImpl3D::_set_built_jolt_ref(const JPH::ShapeRefC& p_jolt_ref) {
+	if (interned && p_jolt_ref != nullptr) {
+		jolt_ref = JoltShapeInterner::insert(intern_key, p_jolt_ref);
+	} else {
+		jolt_ref = p_jolt_ref;
+	}
+}
+
+void JoltShapeImpl3D::_finish_cooking() {
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(cook_task_id);
+
+	cook_task_id = -1;
+	cook_owners_string = String();
+
+	cooking_failed = cooked_jolt_ref == nullptr;
+
+	_set_built_jolt_ref(cooked_jolt_ref);
+
+	cooked_jolt_ref = nullptr;
+}
+
+void JoltShapeImpl3D::_cook(void* p_user_data) {
+	auto* shape = static_cast<JoltShapeImpl3D*>(p_user_data);
+
+	shape->cooked_jolt_ref = shape->_build();
+}
+
+void JoltShapeImpl3D::_release_jolt_ref() {
+	if (interned && jolt_ref != nullptr) {
+		JoltShapeInterner::release(intern_key, jolt_ref);
+	}
+
+	jolt_ref = nullptr;
+	intern_key = {};
+	interned = false;
+}
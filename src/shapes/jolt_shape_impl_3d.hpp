@@ -1,8 +1,16 @@
 #pragma once
 
+#include "shapes/jolt_shape_interner.hpp"
+
+class JoltCharacterImpl3D;
+class JoltQueryImpl3D;
 class JoltShapedObjectImpl3D;
 
 class JoltShapeImpl3D {
+	using Mutex = std::recursive_mutex;
+
+	using MutexLock = std::unique_lock<Mutex>;
+
 public:
 	using ShapeType = PhysicsServer3D::ShapeType;
 
@@ -16,6 +24,15 @@ public:
 
 	void remove_owner(JoltShapedObjectImpl3D* p_owner);
 
+	void add_character(JoltCharacterImpl3D* p_character);
+
+	void remove_character(JoltCharacterImpl3D* p_character);
+
+	// Safe to call from any thread, since queries can be made from outside of the main thread.
+	void add_query(JoltQueryImpl3D* p_query);
+
+	void remove_query(JoltQueryImpl3D* p_query);
+
 	void remove_self();
 
 	virtual ShapeType get_type() const = 0;
@@ -36,8 +53,16 @@ public:
 
 	void set_solver_bias(float p_bias);
 
+	// Safe to call from any thread, since queries can be made from outside of the main thread, but
+	// the shape's data must not be modified at the same time.
 	JPH::ShapeRefC try_build();
 
+	JPH::ShapeRefC try_build_in_background();
+
+	bool is_cooking() const { return cook_task_id != -1; }
+
+	void cancel_cooking();
+
 	void destroy();
 
 	const JPH::Shape* get_jolt_ref() const { return jolt_ref; }
@@ -64,6 +89,19 @@ public:
 
 	static JPH::ShapeRefC with_double_sided(const JPH::Shape* p_shape, bool p_back_face_collision);
 
+	static JPH::ShapeRefC with_user_data_and_scale(
+		const JPH::Shape* p_shape,
+		uint64_t p_user_data,
+		const Vector3& p_scale
+	);
+
+	static JPH::ShapeRefC with_decorations(
+		const JPH::Shape* p_shape,
+		const Vector3& p_scale,
+		const Vector3& p_center_of_mass_offset,
+		bool p_double_sided
+	);
+
 	static JPH::ShapeRefC without_custom_shapes(const JPH::Shape* p_shape);
 
 	static Vector3 make_scale_valid(const JPH::Shape* p_shape, const Vector3& p_scale);
@@ -74,16 +112,63 @@ public:
 		real_t p_tolerance = 0.01f
 	);
 
+	static void finish_cooked_shapes();
+
 protected:
 	virtual JPH::ShapeRefC _build() const = 0;
 
+	virtual bool _is_expensive_to_build() const { return false; }
+
+	// Only shapes with enough data for the sharing to pay for the hashing opt into interning.
+	virtual bool _can_be_interned() const { return false; }
+
+	virtual void _hash_intern_data([[maybe_unused]] const Ref<HashingContext>& p_context) const { }
+
 	String _owners_to_string() const;
 
+	void _notify_owners();
+
+	void _notify_owners_modified_in_place();
+
+	bool _try_find_interned();
+
+	void _set_built_jolt_ref(const JPH::ShapeRefC& p_jolt_ref);
+
+	void _finish_cooking();
+
+	static void _cook(void* p_user_data);
+
+	void _release_jolt_ref();
+
+	inline static HashSet<JoltShapeImpl3D*> cooking_shapes;
+
+	inline static std::mutex cooking_shapes_mutex;
+
 	HashMap<JoltShapedObjectImpl3D*, int32_t> ref_counts_by_owner;
 
+	HashSet<JoltCharacterImpl3D*> characters;
+
+	HashSet<JoltQueryImpl3D*> queries;
+
 	RID rid;
 
 	JPH::ShapeRefC jolt_ref;
+
+	JPH::ShapeRefC cooked_jolt_ref;
+
+	mutable Mutex build_mutex;
+
+	std::mutex queries_mutex;
+
+	String cook_owners_string;
+
+	JoltShapeInterner::Key intern_key;
+
+	int64_t cook_task_id = -1;
+
+	bool interned = false;
+
+	bool cooking_failed = false;
 };
 
 #ifdef GDJ_CONFIG_EDITOR
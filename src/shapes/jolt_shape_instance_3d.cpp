@@ -32,6 +32,12 @@ JoltShapeInstance3D::~JoltShapeInstance3D() {
 	}
 }
 
+const JPH::Shape* JoltShapeInstance3D::get_jolt_inner_ref() const {
+	QUIET_FAIL_NULL_D(jolt_ref);
+
+	return static_cast<const JPH::DecoratedShape*>(jolt_ref.GetPtr())->GetInnerShape();
+}
+
 AABB JoltShapeInstance3D::get_aabb() const {
 	return get_transform_scaled().xform(shape->get_aabb());
 }
@@ -39,7 +45,9 @@ AABB JoltShapeInstance3D::get_aabb() const {
 bool JoltShapeInstance3D::try_build() {
 	ERR_FAIL_COND_D(is_disabled());
 
-	const JPH::ShapeRefC maybe_new_shape = shape->try_build();
+	// Shapes that are still being cooked in the background will end up notifying us once they're
+	// done, at which point we'll get rebuilt, so we simply go without them until then.
+	const JPH::ShapeRefC maybe_new_shape = shape->try_build_in_background();
 
 	if (maybe_new_shape == nullptr) {
 		jolt_ref = nullptr;
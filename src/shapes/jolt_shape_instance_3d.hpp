@@ -25,6 +25,8 @@ public:
 
 	const JPH::Shape* get_jolt_ref() const { return jolt_ref; }
 
+	const JPH::Shape* get_jolt_inner_ref() const;
+
 	const Transform3D& get_transform_unscaled() const { return transform; }
 
 	Transform3D get_transform_scaled() const { return transform.scaled_local(scale); }
@@ -0,0 +1,119 @@
+#include "jolt_shape_interner.hpp"
+
+namespace {
+
+using Mutex = std::mutex;
+using MutexLock = std::unique_lock<Mutex>;
+
+using Key = JoltShapeInterner::Key;
+
+constexpr int32_t MIN_PRUNE_THRESHOLD = 64;
+
+HashMap<Key, JPH::ShapeRefC, Key> interned_shapes;
+
+Mutex interned_shapes_mutex;
+
+int32_t prune_threshold = MIN_PRUNE_THRESHOLD;
+
+bool prune_requested = false;
+
+void prune_interned_shapes() {
+	// Shapes whose only remaining reference is the one held by the table itself are no longer used
+	// by any shape resource or object, so we can let go of them.
+	interned_shapes.erase_if([](const auto& p_entry) {
+		return p_entry.second->GetRefCount() <= 1;
+	});
+
+	prune_threshold = MAX(interned_shapes.size() * 2, MIN_PRUNE_THRESHOLD);
+	prune_requested = false;
+}
+
+} // namespace
+
+Key JoltShapeInterner::make_key(
+	PhysicsServer3D::ShapeType p_type,
+	const PackedByteArray& p_digest,
+	float p_margin
+) {
+	Key key;
+
+	ERR_FAIL_COND_V(p_digest.size() != (int64_t)key.digest.size(), key);
+	memcpy(key.digest.data(), p_digest.ptr(), key.digest.size());
+
+	uint32_t digest_prefix = 0;
+	memcpy(&digest_prefix, key.digest.data(), sizeof(digest_prefix));
+
+	uint32_t hash = hash_murmur3_one_32((uint32_t)p_type);
+	hash = hash_murmur3_one_32(digest_prefix, hash);
+	hash = hash_murmur3_one_float(p_margin, hash);
+
+	key.hash_value = hash_fmix32(hash);
+	key.type = p_type;
+	key.margin = p_margin;
+
+	return key;
+}
+
+JPH::ShapeRefC JoltShapeInterner::find(const Key& p_key) {
+	const MutexLock lock(interned_shapes_mutex);
+
+	const JPH::ShapeRefC* shape = interned_shapes.getptr(p_key);
+
+	return shape != nullptr ? *shape : nullptr;
+}
+
+JPH::ShapeRefC JoltShapeInterner::insert(const Key& p_key, const JPH::Shape* p_shape) {
+	ERR_FAIL_NULL_D(p_shape);
+
+	const MutexLock lock(interned_shapes_mutex);
+
+	// Another shape with the same data might have beaten us to it, in which case we use theirs
+	// and let ours be freed.
+	if (const JPH::ShapeRefC* existing_shape = interned_shapes.getptr(p_key)) {
+		return *existing_shape;
+	}
+
+	if (interned_shapes.size() >= prune_threshold) {
+		prune_interned_shapes();
+	}
+
+	interned_shapes.insert(p_key, p_shape);
+
+	return p_shape;
+}
+
+void JoltShapeInterner::release(const Key& p_key, const JPH::Shape* p_shape) {
+	ERR_FAIL_NULL(p_shape);
+
+	const MutexLock lock(interned_shapes_mutex);
+
+	const auto iter = interned_shapes.find(p_key);
+	QUIET_FAIL_COND(iter == interned_shapes.end());
+	QUIET_FAIL_COND(iter->second != p_shape);
+
+	// We only erase the shape right away if the caller and the table are the only ones holding on
+	// to it. The owners of the shape resource are usually still holding on to it at this point,
+	// since they only rebuild after being notified of the change, so we prune it once they've had
+	// a chance to let go of it.
+	if (p_shape->GetRefCount() <= 2) {
+		interned_shapes.remove(iter);
+	} else {
+		prune_requested = true;
+	}
+}
+
+void JoltShapeInterner::prune() {
+	const MutexLock lock(interned_shapes_mutex);
+
+	if (prune_requested) {
+		prune_interned_shapes();
+	}
+}
+
+void JoltShapeInterner::clear() {
+	const MutexLock lock(interned_shapes_mutex);
+
+	interned_shapes.clear();
+	prune_threshold = MIN_PRUNE_THRESHOLD;
+	prune_requested = false;
+}
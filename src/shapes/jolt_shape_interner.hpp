@@ -0,0 +1,40 @@
+#pragma once
+
+// Keeps track of the shapes built by `JoltShapeImpl3D`, keyed on their type and a digest of their
+// data, so that shape resources with identical data end up sharing the same immutable Jolt shape.
+class JoltShapeInterner {
+public:
+	struct Key {
+		static uint32_t hash(const Key& p_key) { return p_key.hash_value; }
+
+		friend bool operator==(const Key& p_lhs, const Key& p_rhs) {
+			return p_lhs.hash_value == p_rhs.hash_value && p_lhs.type == p_rhs.type &&
+				p_lhs.margin == p_rhs.margin && p_lhs.digest == p_rhs.digest;
+		}
+
+		// SHA-256 of the shape data, which lets us avoid holding on to the data itself.
+		std::array<uint8_t, 32> digest = {};
+
+		uint32_t hash_value = 0;
+
+		PhysicsServer3D::ShapeType type = {};
+
+		float margin = 0.0f;
+	};
+
+	static Key make_key(
+		PhysicsServer3D::ShapeType p_type,
+		const PackedByteArray& p_digest,
+		float p_margin
+	);
+
+	static JPH::ShapeRefC find(const Key& p_key);
+
+	static JPH::ShapeRefC insert(const Key& p_key, const JPH::Shape* p_shape);
+
+	static void release(const Key& p_key, const JPH::Shape* p_shape);
+
+	static void prune();
+
+	static void clear();
+};
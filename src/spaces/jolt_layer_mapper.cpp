@@ -2,6 +2,7 @@
 
 #include "servers/jolt_project_settings.hpp"
 #include "spaces/jolt_broad_phase_layer.hpp"
+#include "spaces/jolt_object_layer.hpp"
 
 namespace {
 
@@ -56,24 +57,6 @@ private:
 	uint8_t masks[TSize] = {};
 };
 
-constexpr JPH::ObjectLayer encode_layers(
-	JPH::BroadPhaseLayer p_broad_phase_layer,
-	JPH::ObjectLayer p_object_layer
-) {
-	const auto upper_bits = uint16_t((uint8_t)p_broad_phase_layer << 13U);
-	const auto lower_bits = uint16_t(p_object_layer);
-	return JPH::ObjectLayer(upper_bits | lower_bits);
-}
-
-constexpr void decode_layers(
-	JPH::ObjectLayer p_encoded_layers,
-	JPH::BroadPhaseLayer& p_broad_phase_layer,
-	JPH::ObjectLayer& p_object_layer
-) {
-	p_broad_phase_layer = JPH::BroadPhaseLayer(uint8_t(p_encoded_layers >> 13U));
-	p_object_layer = JPH::ObjectLayer(p_encoded_layers & 0b0001'1111'1111'1111U);
-}
-
 constexpr uint64_t encode_collision(uint32_t p_collision_layer, uint32_t p_collision_mask) {
 	const auto upper_bits = (uint64_t)p_collision_layer << 32U;
 	const auto lower_bits = (uint64_t)p_collision_mask;
@@ -89,6 +72,9 @@ constexpr void decode_collision(
 	p_collision_mask = uint32_t(p_collision & 0xFFFFFFFFU);
 }
 
+using JoltObjectLayer::decode_layers;
+using JoltObjectLayer::encode_layers;
+
 } // namespace
 
 JoltLayerMapper::JoltLayerMapper() {
@@ -108,7 +94,7 @@ JPH::ObjectLayer JoltLayerMapper::to_object_layer(
 	if (iter != layers_by_collision.end()) {
 		object_layer = iter->second;
 	} else {
-		constexpr uint16_t object_layer_count = 1U << 13U;
+		constexpr uint32_t object_layer_count = JoltObjectLayer::COUNT;
 
 		ERR_FAIL_COND_D_REPORT(
 			next_object_layer == object_layer_count,
@@ -140,6 +126,37 @@ void JoltLayerMapper::from_object_layer(
 	decode_collision(collision, p_collision_layer, p_collision_mask);
 }
 
+void JoltLayerMapper::get_object_layers_in_mask(
+	uint32_t p_collision_mask,
+	JoltObjectLayerSet& p_layers
+) const {
+	// Query and motion filters are created for pretty much every query, and there are typically
+	// only a handful of distinct collision masks in use, so we cache the set for each mask rather
+	// than scanning every object layer each time.
+	const std::unique_lock<std::mutex> object_layers_lock(object_layers_mutex);
+
+	if (const JoltObjectLayerSet* cached_layers = object_layers_by_mask.getptr(p_collision_mask)) {
+		p_layers = *cached_layers;
+		return;
+	}
+
+	JoltObjectLayerSet& layers = object_layers_by_mask[p_collision_mask];
+
+	const int32_t layer_count = collisions_by_layer.size();
+
+	for (int32_t i = 0; i < layer_count; ++i) {
+		uint32_t collision_layer = 0;
+		uint32_t collision_mask = 0;
+		decode_collision(collisions_by_layer[i], collision_layer, collision_mask);
+
+		if ((p_collision_mask & collision_layer) != 0) {
+			layers.insert((JPH::ObjectLayer)i);
+		}
+	}
+
+	p_layers = layers;
+}
+
 uint32_t JoltLayerMapper::GetNumBroadPhaseLayers() const {
 	return JoltBroadPhaseLayer::COUNT;
 }
@@ -220,6 +237,10 @@ JPH::ObjectLayer JoltLayerMapper::_allocate_object_layer(uint64_t p_collision) {
 
 	layers_by_collision[p_collision] = new_object_layer;
 
+	const std::unique_lock<std::mutex> object_layers_lock(object_layers_mutex);
+
+	object_layers_by_mask.clear();
+
 	return new_object_layer;
 }
 
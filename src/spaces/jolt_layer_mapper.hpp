@@ -1,5 +1,7 @@
 #pragma once
 
+#include "spaces/jolt_object_layer_set.hpp"
+
 class JoltLayerMapper final
 	: public JPH::BroadPhaseLayerInterface
 	, public JPH::ObjectLayerPairFilter
@@ -20,6 +22,8 @@ public:
 		uint32_t& p_collision_mask
 	) const;
 
+	void get_object_layers_in_mask(uint32_t p_collision_mask, JoltObjectLayerSet& p_layers) const;
+
 private:
 	uint32_t GetNumBroadPhaseLayers() const override;
 
@@ -45,5 +49,9 @@ private:
 
 	HashMap<uint64_t, JPH::ObjectLayer> layers_by_collision;
 
+	mutable HashMap<uint32_t, JoltObjectLayerSet> object_layers_by_mask;
+
+	mutable std::mutex object_layers_mutex;
+
 	JPH::ObjectLayer next_object_layer = 0;
 };
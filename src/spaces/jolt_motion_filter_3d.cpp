@@ -14,7 +14,9 @@ JoltMotionFilter3D::JoltMotionFilter3D(const JoltBodyImpl3D& p_body, bool p_coll
 	: physics_server(*JoltPhysicsServer3DExtension::get_singleton())
 	, body_self(p_body)
 	, space(*body_self.get_space())
-	, collide_separation_ray(p_collide_separation_ray) { }
+	, collide_separation_ray(p_collide_separation_ray) {
+	space.get_object_layers_in_mask(body_self.get_collision_mask(), accepted_object_layers);
+}
 
 bool JoltMotionFilter3D::ShouldCollide(JPH::BroadPhaseLayer p_broad_phase_layer) const {
 	const auto broad_phase_layer = (JPH::BroadPhaseLayer::Type)p_broad_phase_layer;
@@ -36,18 +38,7 @@ bool JoltMotionFilter3D::ShouldCollide(JPH::BroadPhaseLayer p_broad_phase_layer)
 }
 
 bool JoltMotionFilter3D::ShouldCollide(JPH::ObjectLayer p_object_layer) const {
-	JPH::BroadPhaseLayer object_broad_phase_layer = {};
-	uint32_t object_collision_layer = 0;
-	uint32_t object_collision_mask = 0;
-
-	space.map_from_object_layer(
-		p_object_layer,
-		object_broad_phase_layer,
-		object_collision_layer,
-		object_collision_mask
-	);
-
-	return (body_self.get_collision_mask() & object_collision_layer) != 0;
+	return accepted_object_layers.has(p_object_layer);
 }
 
 bool JoltMotionFilter3D::ShouldCollide(const JPH::BodyID& p_jolt_id) const {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "spaces/jolt_object_layer_set.hpp"
+
 class JoltBodyImpl3D;
 class JoltPhysicsServer3DExtension;
 class JoltSpace3D;
@@ -39,5 +41,7 @@ private:
 
 	const JoltSpace3D& space;
 
+	JoltObjectLayerSet accepted_object_layers;
+
 	bool collide_separation_ray = false;
 };
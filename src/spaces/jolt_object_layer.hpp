@@ -0,0 +1,33 @@
+#pragma once
+
+// Every object layer handed to Jolt is encoded with its broad phase layer in the upper 3 bits and
+// an index into the layer mapper's combinations of collision layers and masks in the lower 13 bits.
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+namespace JoltObjectLayer {
+
+constexpr uint32_t INDEX_BITS = 13;
+
+constexpr uint32_t INDEX_MASK = (1U << INDEX_BITS) - 1U;
+
+constexpr uint32_t COUNT = 1U << INDEX_BITS;
+
+constexpr JPH::ObjectLayer encode_layers(
+	JPH::BroadPhaseLayer p_broad_phase_layer,
+	JPH::ObjectLayer p_object_layer
+) {
+	const auto upper_bits = uint16_t((uint8_t)p_broad_phase_layer << INDEX_BITS);
+	const auto lower_bits = uint16_t(p_object_layer);
+	return JPH::ObjectLayer(upper_bits | lower_bits);
+}
+
+constexpr void decode_layers(
+	JPH::ObjectLayer p_encoded_layers,
+	JPH::BroadPhaseLayer& p_broad_phase_layer,
+	JPH::ObjectLayer& p_object_layer
+) {
+	p_broad_phase_layer = JPH::BroadPhaseLayer(uint8_t(p_encoded_layers >> INDEX_BITS));
+	p_object_layer = JPH::ObjectLayer(p_encoded_layers & INDEX_MASK);
+}
+
+} // namespace JoltObjectLayer
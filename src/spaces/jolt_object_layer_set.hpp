@@ -0,0 +1,44 @@
+#pragma once
+
+#include "spaces/jolt_object_layer.hpp"
+
+// A set of object layers, stored as a bitset indexed by the object layer part of an encoded layer,
+// meant for filters that need to test many candidates against the same collision mask.
+class JoltObjectLayerSet {
+	using Word = uint64_t;
+
+	static constexpr uint32_t WORD_BITS = sizeof(Word) * 8;
+
+	// Enough to hold every possible object layer, so that these never need to allocate.
+	static constexpr uint32_t MAX_WORDS = JoltObjectLayer::COUNT / WORD_BITS;
+
+public:
+	_FORCE_INLINE_ void insert(JPH::ObjectLayer p_object_layer) {
+		const uint32_t word_index = p_object_layer / WORD_BITS;
+
+		if (word_index >= (uint32_t)words.size()) {
+			words.resize((int32_t)word_index + 1);
+		}
+
+		words[(int32_t)word_index] |= Word(1) << (p_object_layer % WORD_BITS);
+	}
+
+	_FORCE_INLINE_ bool has(JPH::ObjectLayer p_encoded_layer) const {
+		JPH::BroadPhaseLayer broad_phase_layer = {};
+		JPH::ObjectLayer object_layer = 0;
+		JoltObjectLayer::decode_layers(p_encoded_layer, broad_phase_layer, object_layer);
+
+		const uint32_t word_index = object_layer / WORD_BITS;
+
+		if (word_index >= (uint32_t)words.size()) {
+			return false;
+		}
+
+		return (words[(int32_t)word_index] & (Word(1) << (object_layer % WORD_BITS))) != 0;
+	}
+
+	_FORCE_INLINE_ void clear() { words.clear(); }
+
+private:
+	InlineVector<Word, MAX_WORDS> words;
+};
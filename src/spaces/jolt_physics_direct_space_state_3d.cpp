@@ -10,11 +10,227 @@
 #include "spaces/jolt_motion_filter_3d.hpp"
 #include "spaces/jolt_query_collectors.hpp"
 #include "spaces/jolt_query_filter_3d.hpp"
+#include "spaces/jolt_query_impl_3d.hpp"
 #include "spaces/jolt_space_3d.hpp"
 
+namespace {
+
+void decompose_query_transform(
+	const JPH::Shape* p_jolt_shape,
+	const Transform3D& p_transform,
+	const char* p_error_message,
+	Transform3D& p_transform_com,
+	Vector3& p_scale
+) {
+	Transform3D transform = p_transform;
+
+	ENSURE_SCALE_NOT_ZERO(transform, p_error_message);
+
+	Math::decompose(transform, p_scale);
+
+	ENSURE_SCALE_VALID(p_jolt_shape, p_scale, p_error_message);
+
+	const Vector3 com_scaled = to_godot(p_jolt_shape->GetCenterOfMass());
+	p_transform_com = transform.translated_local(com_scaled);
+}
+
+const JPH::BodyID& get_hit_body_id(const JPH::CollidePointResult& p_hit) {
+	return p_hit.mBodyID;
+}
+
+const JPH::BodyID& get_hit_body_id(const JPH::CollideShapeResult& p_hit) {
+	return p_hit.mBodyID2;
+}
+
+template<typename TCollector>
+int32_t resolve_shape_results(
+	const JoltSpace3D& p_space,
+	const TCollector& p_collector,
+	PhysicsServer3DExtensionShapeResult* p_results
+) {
+	const int32_t hit_count = p_collector.get_hit_count();
+
+	if (hit_count == 0) {
+		return 0;
+	}
+
+	JoltQueryScratch<JPH::BodyID> body_ids;
+
+	for (int32_t i = 0; i < hit_count; ++i) {
+		body_ids.push_back(get_hit_body_id(p_collector.get_hit(i)));
+	}
+
+	// We lock all the bodies at once, rather than one at a time, since we might be resolving quite
+	// a lot of hits here and there's no telling how many of them share the same body.
+	const JoltScopedBodyReader3D jolt_bodies(p_space, body_ids.ptr(), hit_count);
+
+	for (int32_t i = 0; i < hit_count; ++i) {
+		const JPH::Body* jolt_body = jolt_bodies.try_get(i);
+		ERR_FAIL_NULL_D(jolt_body);
+
+		const auto* object = reinterpret_cast<const JoltObjectImpl3D*>(jolt_body->GetUserData());
+
+		PhysicsServer3DExtensionShapeResult& result = *p_results++;
+
+		result.rid = object->get_rid();
+		result.collider_id = object->get_instance_id();
+		result.collider = object->get_instance_unsafe();
+		result.shape = 0;
+
+		if (const JoltShapedObjectImpl3D* shaped_object = object->as_shaped()) {
+			const JPH::SubShapeID& sub_shape_id = p_collector.get_hit(i).mSubShapeID2;
+			const int32_t shape_index = shaped_object->find_shape_index(sub_shape_id);
+			ERR_FAIL_COND_D(shape_index == -1);
+			result.shape = shape_index;
+		}
+	}
+
+	return hit_count;
+}
+
+void collect_recovery_neighbors(
+	const JoltSpace3D& p_space,
+	const JPH::Shape& p_jolt_shape,
+	const Transform3D& p_transform_com,
+	float p_extent,
+	const JoltMotionFilter3D& p_motion_filter,
+	JoltBodyImpl3D::RecoveryNeighbors& p_neighbors
+) {
+	p_neighbors.clear();
+
+	JPH::AABox aabb = p_jolt_shape.GetWorldSpaceBounds(
+		to_jolt_r(p_transform_com),
+		JPH::Vec3::sOne()
+	);
+
+	aabb.ExpandBy(JPH::Vec3::sReplicate(p_extent));
+
+	JoltQueryCollectorAnyMultiScratch<JPH::CollideShapeBodyCollector> collector;
+
+	p_space.get_broad_phase_query().CollideAABox(aabb, collector, p_motion_filter, p_motion_filter);
+
+	const int32_t hit_count = collector.get_hit_count();
+
+	if (hit_count == 0) {
+		return;
+	}
+
+	const JoltScopedBodyReader3D jolt_bodies(p_space, &collector.get_hit(0), hit_count);
+
+	for (int32_t i = 0; i < hit_count; ++i) {
+		const JPH::Body* jolt_body = jolt_bodies.try_get(i);
+
+		if (jolt_body == nullptr || !p_motion_filter.ShouldCollide(jolt_body->GetID()) ||
+			!p_motion_filter.ShouldCollideLocked(*jolt_body))
+		{
+			continue;
+		}
+
+		const auto* object = reinterpret_cast<const JoltObjectImpl3D*>(jolt_body->GetUserData());
+		const JoltBodyImpl3D* body = object->as_body();
+		ERR_CONTINUE(body == nullptr);
+
+		JoltBodyImpl3D::RecoveryNeighbor neighbor;
+		neighbor.jolt_id = jolt_body->GetID();
+		neighbor.position = jolt_body->GetPosition();
+		neighbor.rotation = jolt_body->GetRotation();
+		neighbor.jolt_shape = jolt_body->GetShape();
+		neighbor.object_layer = jolt_body->GetObjectLayer();
+		neighbor.shape_revision = body->get_shape_revision();
+		neighbor.priority = body->get_collision_priority();
+
+		p_neighbors.push_back(std::move(neighbor));
+	}
+
+	// The broad phase makes no promises about the order in which it reports things, so we sort
+	// them to make sure that two sets of neighbors can be compared as-is.
+	using Neighbor = JoltBodyImpl3D::RecoveryNeighbor;
+
+	p_neighbors.sort([](const Neighbor& p_lhs, const Neighbor& p_rhs) {
+		return p_lhs.jolt_id < p_rhs.jolt_id;
+	});
+}
+
+bool recovery_neighbors_match(
+	const JoltBodyImpl3D::RecoveryNeighbors& p_lhs,
+	const JoltBodyImpl3D::RecoveryNeighbors& p_rhs
+) {
+	if (p_lhs.size() != p_rhs.size()) {
+		return false;
+	}
+
+	for (int32_t i = 0; i < p_lhs.size(); ++i) {
+		if (!(p_lhs[i] == p_rhs[i])) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+} // namespace
+
+// Guards against queries being performed while the space is being stepped, which can only happen
+// when queries are performed from other threads, with the "Allow Concurrent Queries" project
+// setting enabled. Any query that gets past this will hold off the next step until it finishes.
+#define ENSURE_NOT_STEPPING_D()                                             \
+	ERR_FAIL_COND_D_MSG(                                                    \
+		!space->try_begin_query(),                                          \
+		vformat(                                                            \
+			"%s can't be called while the physics space is being stepped.", \
+			__FUNCTION__                                                    \
+		)                                                                   \
+	);                                                                      \
+	ON_SCOPE_EXIT {                                                         \
+		space->end_query();                                                 \
+	}
+
+uint32_t JoltPhysicsDirectSpaceState3DExtension::QueryCacheKey::hash(const QueryCacheKey& p_key) {
+	const Basis& basis = p_key.transform.basis;
+	const Vector3& origin = p_key.transform.origin;
+
+	uint32_t hash = hash_murmur3_one_64((uint64_t)p_key.jolt_shape.GetPtr());
+
+	for (int32_t i = 0; i < 3; ++i) {
+		hash = hash_murmur3_one_real(basis.rows[i].x, hash);
+		hash = hash_murmur3_one_real(basis.rows[i].y, hash);
+		hash = hash_murmur3_one_real(basis.rows[i].z, hash);
+	}
+
+	hash = hash_murmur3_one_real(origin.x, hash);
+	hash = hash_murmur3_one_real(origin.y, hash);
+	hash = hash_murmur3_one_real(origin.z, hash);
+	hash = hash_murmur3_one_real(p_key.margin, hash);
+	hash = hash_murmur3_one_32(p_key.collision_mask, hash);
+	hash = hash_murmur3_one_32((uint32_t)p_key.collide_with_bodies, hash);
+	hash = hash_murmur3_one_32((uint32_t)p_key.collide_with_areas, hash);
+
+	return hash_fmix32(hash);
+}
+
 JoltPhysicsDirectSpaceState3DExtension::JoltPhysicsDirectSpaceState3DExtension(JoltSpace3D* p_space)
 	: space(p_space) { }
 
+void JoltPhysicsDirectSpaceState3DExtension::_bind_methods() {
+	// clang-format off
+
+	BIND_METHOD(JoltPhysicsDirectSpaceState3DExtension, intersect_rays, "origins", "motions", "collision_mask", "collide_with_bodies", "collide_with_areas", "hit_from_inside", "hit_back_faces");
+	BIND_METHOD(JoltPhysicsDirectSpaceState3DExtension, intersect_ray_all, "from", "to", "collision_mask", "collide_with_bodies", "collide_with_areas", "max_hits", "stop_at_body");
+	BIND_METHOD(JoltPhysicsDirectSpaceState3DExtension, intersect_shapes, "shape", "transforms", "margin", "collision_mask", "collide_with_bodies", "collide_with_areas", "max_results");
+	BIND_METHOD(JoltPhysicsDirectSpaceState3DExtension, cast_motions, "shape", "transforms", "motions", "margin", "collision_mask", "collide_with_bodies", "collide_with_areas");
+	BIND_METHOD(JoltPhysicsDirectSpaceState3DExtension, collide_shapes, "shape", "transforms", "margin", "collision_mask", "collide_with_bodies", "collide_with_areas", "max_results");
+
+	BIND_METHOD(JoltPhysicsDirectSpaceState3DExtension, intersect_ray_async, "from", "to", "collision_mask", "collide_with_bodies", "collide_with_areas", "hit_from_inside", "hit_back_faces");
+	BIND_METHOD(JoltPhysicsDirectSpaceState3DExtension, cast_motion_async, "shape", "transform", "motion", "margin", "collision_mask", "collide_with_bodies", "collide_with_areas");
+	BIND_METHOD(JoltPhysicsDirectSpaceState3DExtension, is_async_result_ready, "ticket");
+	BIND_METHOD(JoltPhysicsDirectSpaceState3DExtension, take_async_result, "ticket");
+
+	BIND_METHOD(JoltPhysicsDirectSpaceState3DExtension, get_query_cache_stats);
+	BIND_METHOD(JoltPhysicsDirectSpaceState3DExtension, reset_query_cache_stats);
+
+	// clang-format on
+}
+
 bool JoltPhysicsDirectSpaceState3DExtension::_intersect_ray(
 	const Vector3& p_from,
 	const Vector3& p_to,
@@ -26,6 +242,8 @@ bool JoltPhysicsDirectSpaceState3DExtension::_intersect_ray(
 	bool p_pick_ray,
 	PhysicsServer3DExtensionRayResult* p_result
 ) {
+	ENSURE_NOT_STEPPING_D();
+
 	space->try_optimize();
 
 	const JoltQueryFilter3D query_filter(
@@ -38,73 +256,110 @@ bool JoltPhysicsDirectSpaceState3DExtension::_intersect_ray(
 
 	const JPH::RVec3 from = to_jolt_r(p_from);
 	const JPH::RVec3 to = to_jolt_r(p_to);
-	const auto vector = JPH::Vec3(to - from);
-	const JPH::RRayCast ray(from, vector);
-
-	const JPH::EBackFaceMode back_face_mode = p_hit_back_faces
-		? JPH::EBackFaceMode::CollideWithBackFaces
-		: JPH::EBackFaceMode::IgnoreBackFaces;
-
-	JPH::RayCastSettings settings;
-	settings.mTreatConvexAsSolid = p_hit_from_inside;
-	settings.mBackFaceModeTriangles = back_face_mode;
-
-	if (JoltProjectSettings::use_legacy_ray_casting()) {
-		settings.mBackFaceModeConvex = back_face_mode;
-	}
-
-	JoltQueryCollectorClosest<JPH::CastRayCollector> collector;
+	const JPH::RRayCast ray(from, JPH::Vec3(to - from));
 
-	space->get_narrow_phase_query().CastRay(
+	return _cast_ray(
 		ray,
-		settings,
-		collector,
+		_make_ray_cast_settings(p_hit_from_inside, p_hit_back_faces),
 		query_filter,
-		query_filter,
-		query_filter
+		p_hit_from_inside,
+		*p_result
 	);
+}
 
-	if (!collector.had_hit()) {
-		return false;
-	}
-
-	const JPH::RayCastResult& hit = collector.get_hit();
+Dictionary JoltPhysicsDirectSpaceState3DExtension::intersect_rays(
+	const PackedVector3Array& p_origins,
+	const PackedVector3Array& p_motions,
+	uint32_t p_collision_mask,
+	bool p_collide_with_bodies,
+	bool p_collide_with_areas,
+	bool p_hit_from_inside,
+	bool p_hit_back_faces
+) {
+	ENSURE_NOT_STEPPING_D();
 
-	const JPH::BodyID& body_id = hit.mBodyID;
-	const JPH::SubShapeID& sub_shape_id = hit.mSubShapeID2;
+	const auto ray_count = (int32_t)p_origins.size();
 
-	const JoltReadableBody3D body = space->read_body(body_id);
-	const JoltObjectImpl3D* object = body.as_object();
-	ERR_FAIL_NULL_D(object);
+	ERR_FAIL_COND_D_MSG(
+		p_motions.size() != ray_count,
+		vformat(
+			"Failed to intersect rays. "
+			"The number of motions (%d) must match the number of origins (%d).",
+			p_motions.size(),
+			ray_count
+		)
+	);
 
-	const JPH::RVec3 position = ray.GetPointOnRay(hit.mFraction);
+	space->try_optimize();
 
-	JPH::Vec3 normal = JPH::Vec3::sZero();
+	const JoltQueryFilter3D
+		query_filter(*this, p_collision_mask, p_collide_with_bodies, p_collide_with_areas);
 
-	if (!p_hit_from_inside || hit.mFraction > 0.0f) {
-		normal = body->GetWorldSpaceSurfaceNormal(sub_shape_id, position);
+	const JPH::RayCastSettings settings = _make_ray_cast_settings(
+		p_hit_from_inside,
+		p_hit_back_faces
+	);
 
-		// HACK(mihe): If we got a back-face normal we need to flip it
-		if (normal.Dot(vector) > 0) {
-			normal = -normal;
+	PackedVector3Array positions;
+	PackedVector3Array normals;
+	PackedInt64Array collider_ids;
+	PackedInt32Array shapes;
+	PackedInt32Array face_indices;
+
+	positions.resize(ray_count);
+	normals.resize(ray_count);
+	collider_ids.resize(ray_count);
+	shapes.resize(ray_count);
+	face_indices.resize(ray_count);
+
+	// We can't safely write to an `Array` from multiple threads, so we gather the RIDs into this
+	// first and then copy them over once all the jobs have finished.
+	LocalVector<RID> rids;
+	rids.resize(ray_count);
+
+	const Vector3* origins_ptr = p_origins.ptr();
+	const Vector3* motions_ptr = p_motions.ptr();
+	Vector3* positions_ptr = positions.ptrw();
+	Vector3* normals_ptr = normals.ptrw();
+	int64_t* collider_ids_ptr = collider_ids.ptrw();
+	int32_t* shapes_ptr = shapes.ptrw();
+	int32_t* face_indices_ptr = face_indices.ptrw();
+
+	space->run_jobs("Ray Casts", ray_count, 64, [&](int32_t p_begin, int32_t p_end) {
+		for (int32_t i = p_begin; i < p_end; ++i) {
+			const JPH::RRayCast ray(to_jolt_r(origins_ptr[i]), to_jolt(motions_ptr[i]));
+
+			PhysicsServer3DExtensionRayResult result = {};
+			result.shape = -1;
+			result.face_index = -1;
+
+			_cast_ray(ray, settings, query_filter, p_hit_from_inside, result);
+
+			positions_ptr[i] = result.position;
+			normals_ptr[i] = result.normal;
+			collider_ids_ptr[i] = (int64_t)result.collider_id;
+			shapes_ptr[i] = result.shape;
+			face_indices_ptr[i] = result.face_index;
+			rids[i] = result.rid;
 		}
-	}
+	});
 
-	p_result->position = to_godot(position);
-	p_result->normal = to_godot(normal);
-	p_result->rid = object->get_rid();
-	p_result->collider_id = object->get_instance_id();
-	p_result->collider = object->get_instance_unsafe();
-	p_result->shape = 0;
+	Array rids_array;
+	rids_array.resize(ray_count);
 
-	if (const JoltShapedObjectImpl3D* shaped_object = object->as_shaped()) {
-		const int32_t shape_index = shaped_object->find_shape_index(sub_shape_id);
-		ERR_FAIL_COND_D(shape_index == -1);
-		p_result->shape = shape_index;
-		p_result->face_index = _try_get_face_index(*body, sub_shape_id);
+	for (int32_t i = 0; i < ray_count; ++i) {
+		rids_array[i] = rids[i];
 	}
 
-	return true;
+	Dictionary results;
+	results["position"] = positions;
+	results["normal"] = normals;
+	results["collider_id"] = collider_ids;
+	results["rid"] = rids_array;
+	results["shape"] = shapes;
+	results["face_index"] = face_indices;
+
+	return results;
 }
 
 int32_t JoltPhysicsDirectSpaceState3DExtension::_intersect_point(
@@ -115,16 +370,28 @@ int32_t JoltPhysicsDirectSpaceState3DExtension::_intersect_point(
 	PhysicsServer3DExtensionShapeResult* p_results,
 	int32_t p_max_results
 ) {
+	ENSURE_NOT_STEPPING_D();
+
 	if (p_max_results == 0) {
 		return 0;
 	}
 
 	space->try_optimize();
 
+	if (JoltProjectSettings::use_query_cache()) {
+		QueryCacheKey key;
+		key.transform.origin = p_position;
+		key.collision_mask = p_collision_mask;
+		key.collide_with_bodies = p_collide_with_bodies;
+		key.collide_with_areas = p_collide_with_areas;
+
+		return _intersect_cached(key, p_results, p_max_results);
+	}
+
 	const JoltQueryFilter3D
 		query_filter(*this, p_collision_mask, p_collide_with_bodies, p_collide_with_areas);
 
-	JoltQueryCollectorAnyMulti<JPH::CollidePointCollector, 32> collector(p_max_results);
+	JoltQueryCollectorAnyMultiScratch<JPH::CollidePointCollector> collector(p_max_results);
 
 	space->get_narrow_phase_query().CollidePoint(
 		to_jolt_r(p_position),
@@ -134,30 +401,7 @@ int32_t JoltPhysicsDirectSpaceState3DExtension::_intersect_point(
 		query_filter
 	);
 
-	const int32_t hit_count = collector.get_hit_count();
-
-	for (int32_t i = 0; i < hit_count; ++i) {
-		const JPH::CollidePointResult& hit = collector.get_hit(i);
-
-		const JoltReadableBody3D body = space->read_body(hit.mBodyID);
-		const JoltObjectImpl3D* object = body.as_object();
-		ERR_FAIL_NULL_D(object);
-
-		PhysicsServer3DExtensionShapeResult& result = *p_results++;
-
-		result.rid = object->get_rid();
-		result.collider_id = object->get_instance_id();
-		result.collider = object->get_instance_unsafe();
-		result.shape = 0;
-
-		if (const JoltShapedObjectImpl3D* shaped_object = object->as_shaped()) {
-			const int32_t shape_index = shaped_object->find_shape_index(hit.mSubShapeID2);
-			ERR_FAIL_COND_D(shape_index == -1);
-			result.shape = shape_index;
-		}
-	}
-
-	return hit_count;
+	return resolve_shape_results(*space, collector, p_results);
 }
 
 int32_t JoltPhysicsDirectSpaceState3DExtension::_intersect_shape(
@@ -171,6 +415,8 @@ int32_t JoltPhysicsDirectSpaceState3DExtension::_intersect_shape(
 	PhysicsServer3DExtensionShapeResult* p_results,
 	int32_t p_max_results
 ) {
+	ENSURE_NOT_STEPPING_D();
+
 	if (p_max_results == 0) {
 		return 0;
 	}
@@ -183,62 +429,41 @@ int32_t JoltPhysicsDirectSpaceState3DExtension::_intersect_shape(
 	const JPH::ShapeRefC jolt_shape = shape->try_build();
 	ERR_FAIL_NULL_D(jolt_shape);
 
-	Transform3D transform = p_transform;
+	if (JoltProjectSettings::use_query_cache()) {
+		QueryCacheKey key;
+		key.jolt_shape = jolt_shape;
+		key.transform = p_transform;
+		key.margin = p_margin;
+		key.collision_mask = p_collision_mask;
+		key.collide_with_bodies = p_collide_with_bodies;
+		key.collide_with_areas = p_collide_with_areas;
 
-	ENSURE_SCALE_NOT_ZERO(transform, "intersect_shape was passed an invalid transform.");
+		return _intersect_cached(key, p_results, p_max_results);
+	}
 
+	Transform3D transform_com;
 	Vector3 scale;
-	Math::decompose(transform, scale);
 
-	ENSURE_SCALE_VALID(jolt_shape, scale, "intersect_shape was passed an invalid transform.");
-
-	const Vector3 com_scaled = to_godot(jolt_shape->GetCenterOfMass());
-	const Transform3D transform_com = transform.translated_local(com_scaled);
-
-	JPH::CollideShapeSettings settings;
-	settings.mMaxSeparationDistance = (float)p_margin;
+	decompose_query_transform(
+		jolt_shape,
+		p_transform,
+		"intersect_shape was passed an invalid transform.",
+		transform_com,
+		scale
+	);
 
 	const JoltQueryFilter3D
 		query_filter(*this, p_collision_mask, p_collide_with_bodies, p_collide_with_areas);
 
-	JoltShapeQueryCollectorAnyMulti<32> collector(p_max_results);
-
-	_collide_shape_queries(
-		jolt_shape,
-		to_jolt(scale),
-		to_jolt_r(transform_com),
-		settings,
-		to_jolt_r(transform_com.origin),
-		collector,
-		query_filter,
+	return _intersect_shape_impl(
+		*jolt_shape,
+		transform_com,
+		scale,
+		(float)p_margin,
 		query_filter,
-		query_filter
+		p_results,
+		p_max_results
 	);
-
-	const int32_t hit_count = collector.get_hit_count();
-
-	for (int32_t i = 0; i < hit_count; ++i) {
-		const JPH::CollideShapeResult& hit = collector.get_hit(i);
-
-		const JoltReadableBody3D body = space->read_body(hit.mBodyID2);
-		const JoltObjectImpl3D* object = body.as_object();
-		ERR_FAIL_NULL_D(object);
-
-		PhysicsServer3DExtensionShapeResult& result = *p_results++;
-
-		result.rid = object->get_rid();
-		result.collider_id = object->get_instance_id();
-		result.collider = object->get_instance_unsafe();
-		result.shape = 0;
-
-		if (const JoltShapedObjectImpl3D* shaped_object = object->as_shaped()) {
-			const int32_t shape_index = shaped_object->find_shape_index(hit.mSubShapeID2);
-			ERR_FAIL_COND_D(shape_index == -1);
-			result.shape = shape_index;
-		}
-	}
-
-	return hit_count;
 }
 
 bool JoltPhysicsDirectSpaceState3DExtension::_cast_motion(
@@ -253,6 +478,8 @@ bool JoltPhysicsDirectSpaceState3DExtension::_cast_motion(
 	real_t* p_closest_unsafe,
 	PhysicsServer3DExtensionShapeRestInfo* p_info
 ) {
+	ENSURE_NOT_STEPPING_D();
+
 	// HACK(mihe): This rest info parameter doesn't seem to be used anywhere within Godot, and isn't
 	// exposed in the bindings, so this will be unsupported until anyone actually needs it.
 	ERR_FAIL_COND_D_MSG(
@@ -268,25 +495,17 @@ bool JoltPhysicsDirectSpaceState3DExtension::_cast_motion(
 	const JPH::ShapeRefC jolt_shape = shape->try_build();
 	ERR_FAIL_NULL_D(jolt_shape);
 
-	Transform3D transform = p_transform;
-
-	ENSURE_SCALE_NOT_ZERO(
-		transform,
-		"cast_motion (maybe from ShapeCast3D?) was passed an invalid transform."
-	);
-
+	Transform3D transform_com;
 	Vector3 scale;
-	Math::decompose(transform, scale);
 
-	ENSURE_SCALE_VALID(
+	decompose_query_transform(
 		jolt_shape,
-		scale,
-		"cast_motion (maybe from ShapeCast3D?) was passed an invalid transform."
+		p_transform,
+		"cast_motion (maybe from ShapeCast3D?) was passed an invalid transform.",
+		transform_com,
+		scale
 	);
 
-	const Vector3 com_scaled = to_godot(jolt_shape->GetCenterOfMass());
-	Transform3D transform_com = transform.translated_local(com_scaled);
-
 	JPH::CollideShapeSettings settings;
 	settings.mMaxSeparationDistance = (float)p_margin;
 
@@ -324,6 +543,8 @@ bool JoltPhysicsDirectSpaceState3DExtension::_collide_shape(
 	int32_t p_max_results,
 	int32_t* p_result_count
 ) {
+	ENSURE_NOT_STEPPING_D();
+
 	*p_result_count = 0;
 
 	if (p_max_results == 0) {
@@ -338,88 +559,31 @@ bool JoltPhysicsDirectSpaceState3DExtension::_collide_shape(
 	const JPH::ShapeRefC jolt_shape = shape->try_build();
 	ERR_FAIL_NULL_D(jolt_shape);
 
-	Transform3D transform = p_transform;
-
-	ENSURE_SCALE_NOT_ZERO(transform, "collide_shape was passed an invalid transform.");
-
+	Transform3D transform_com;
 	Vector3 scale;
-	Math::decompose(transform, scale);
-
-	ENSURE_SCALE_VALID(jolt_shape, scale, "collide_shape was passed an invalid transform.");
-
-	const Vector3 com_scaled = to_godot(jolt_shape->GetCenterOfMass());
-	const Transform3D transform_com = transform.translated_local(com_scaled);
-
-	JPH::CollideShapeSettings settings;
-	settings.mCollectFacesMode = JPH::ECollectFacesMode::CollectFaces;
-	settings.mMaxSeparationDistance = (float)p_margin;
 
-	const Vector3& base_offset = transform_com.origin;
+	decompose_query_transform(
+		jolt_shape,
+		p_transform,
+		"collide_shape was passed an invalid transform.",
+		transform_com,
+		scale
+	);
 
 	const JoltQueryFilter3D
 		query_filter(*this, p_collision_mask, p_collide_with_bodies, p_collide_with_areas);
 
-	JoltShapeQueryCollectorAnyMulti<32> collector(p_max_results);
-
-	_collide_shape_queries(
-		jolt_shape,
-		to_jolt(scale),
-		to_jolt_r(transform_com),
-		settings,
-		to_jolt_r(base_offset),
-		collector,
-		query_filter,
+	return _collide_shape_impl(
+		*jolt_shape,
+		transform_com,
+		scale,
+		(float)p_margin,
 		query_filter,
-		query_filter
+		static_cast<Vector3*>(p_results),
+		p_max_results,
+		*p_result_count
 	);
-
-	if (!collector.had_hit()) {
-		return false;
-	}
-
-	auto* points = static_cast<Vector3*>(p_results);
-
-	const int32_t max_points = p_max_results * 2;
-
-	int32_t point_count = 0;
-
-	for (int32_t i = 0; i < collector.get_hit_count(); ++i) {
-		const JPH::CollideShapeResult& hit = collector.get_hit(i);
-
-		const Vector3 penetration_axis = to_godot(hit.mPenetrationAxis.Normalized());
-		const Vector3 margin_offset = penetration_axis * (float)p_margin;
-
-		JPH::ContactPoints contact_points1;
-		JPH::ContactPoints contact_points2;
-
-		_generate_manifold(
-			hit,
-			contact_points1,
-			contact_points2
-#ifdef JPH_DEBUG_RENDERER
-			,
-			to_jolt_r(base_offset)
-#endif // JPH_DEBUG_RENDERER
-		);
-
-		for (JPH::uint j = 0; j < contact_points1.size(); ++j) {
-			points[point_count++] = base_offset + to_godot(contact_points1[j]) + margin_offset;
-			points[point_count++] = base_offset + to_godot(contact_points2[j]);
-
-			if (point_count >= max_points) {
-				break;
-			}
-		}
-
-		if (point_count >= max_points) {
-			break;
-		}
-	}
-
-	*p_result_count = point_count / 2;
-
-	return true;
-}
+}
 
 bool JoltPhysicsDirectSpaceState3DExtension::_rest_info(
 	const RID& p_shape_rid,
@@ -431,6 +595,8 @@ bool JoltPhysicsDirectSpaceState3DExtension::_rest_info(
 	bool p_collide_with_areas,
 	PhysicsServer3DExtensionShapeRestInfo* p_info
 ) {
+	ENSURE_NOT_STEPPING_D();
+
 	space->try_optimize();
 
 	JoltShapeImpl3D* shape = JoltPhysicsServer3DExtension::get_singleton()->get_shape(p_shape_rid);
@@ -439,79 +605,36 @@ bool JoltPhysicsDirectSpaceState3DExtension::_rest_info(
 	const JPH::ShapeRefC jolt_shape = shape->try_build();
 	ERR_FAIL_NULL_D(jolt_shape);
 
-	Transform3D transform = p_transform;
-
-	ENSURE_SCALE_NOT_ZERO(
-		transform,
-		"get_rest_info (maybe from ShapeCast3D?) was passed an invalid transform."
-	);
-
+	Transform3D transform_com;
 	Vector3 scale;
-	Math::decompose(transform, scale);
 
-	ENSURE_SCALE_VALID(
+	decompose_query_transform(
 		jolt_shape,
-		scale,
-		"get_rest_info (maybe from ShapeCast3D?) was passed an invalid transform."
+		p_transform,
+		"get_rest_info (maybe from ShapeCast3D?) was passed an invalid transform.",
+		transform_com,
+		scale
 	);
 
-	const Vector3 com_scaled = to_godot(jolt_shape->GetCenterOfMass());
-	const Transform3D transform_com = transform.translated_local(com_scaled);
-
-	JPH::CollideShapeSettings settings;
-	settings.mMaxSeparationDistance = (float)p_margin;
-
-	const Vector3& base_offset = transform_com.origin;
-
 	const JoltQueryFilter3D
 		query_filter(*this, p_collision_mask, p_collide_with_bodies, p_collide_with_areas);
 
-	JoltShapeQueryCollectorClosest collector;
-
-	_collide_shape_queries(
-		jolt_shape,
-		to_jolt(scale),
-		to_jolt_r(transform_com),
-		settings,
-		to_jolt_r(base_offset),
-		collector,
-		query_filter,
+	return _rest_info_impl(
+		*jolt_shape,
+		transform_com,
+		scale,
+		(float)p_margin,
 		query_filter,
-		query_filter
+		*p_info
 	);
-
-	if (!collector.had_hit()) {
-		return false;
-	}
-
-	const JPH::CollideShapeResult& hit = collector.get_hit();
-
-	const JoltReadableBody3D body = space->read_body(hit.mBodyID2);
-	const JoltObjectImpl3D* object = body.as_object();
-	ERR_FAIL_NULL_D(object);
-
-	const Vector3 hit_point = base_offset + to_godot(hit.mContactPointOn2);
-
-	p_info->point = hit_point;
-	p_info->normal = to_godot(-hit.mPenetrationAxis.Normalized());
-	p_info->rid = object->get_rid();
-	p_info->collider_id = object->get_instance_id();
-	p_info->shape = 0;
-	p_info->linear_velocity = object->get_velocity_at_position(hit_point);
-
-	if (const JoltShapedObjectImpl3D* shaped_object = object->as_shaped()) {
-		const int32_t shape_index = shaped_object->find_shape_index(hit.mSubShapeID2);
-		ERR_FAIL_COND_D(shape_index == -1);
-		p_info->shape = shape_index;
-	}
-
-	return true;
 }
 
 Vector3 JoltPhysicsDirectSpaceState3DExtension::_get_closest_point_to_object_volume(
 	const RID& p_object,
 	const Vector3& p_point
 ) const {
+	ENSURE_NOT_STEPPING_D();
+
 	space->try_optimize();
 
 	JoltPhysicsServer3DExtension* physics_server = JoltPhysicsServer3DExtension::get_singleton();
@@ -584,107 +707,1203 @@ Vector3 JoltPhysicsDirectSpaceState3DExtension::_get_closest_point_to_object_vol
 			point_on_b
 		);
 
-		if (distance_sq == 0.0f) {
-			closest_point = point;
-			found_point = true;
+		if (distance_sq == 0.0f) {
+			closest_point = point;
+			found_point = true;
+			break;
+		}
+
+		if (distance_sq < closest_distance_sq) {
+			closest_distance_sq = distance_sq;
+			closest_point = shape_4x4 * point_on_a;
+			found_point = true;
+		}
+	}
+
+	if (found_point) {
+		return to_godot(closest_point);
+	} else {
+		return to_godot(body->GetPosition());
+	}
+}
+
+Dictionary JoltPhysicsDirectSpaceState3DExtension::intersect_ray_all(
+	const Vector3& p_from,
+	const Vector3& p_to,
+	uint32_t p_collision_mask,
+	bool p_collide_with_bodies,
+	bool p_collide_with_areas,
+	int32_t p_max_hits,
+	bool p_stop_at_body
+) {
+	ENSURE_NOT_STEPPING_D();
+
+	ERR_FAIL_COND_D_MSG(
+		p_max_hits <= 0,
+		vformat(
+			"Failed to intersect ray. "
+			"The maximum number of hits must be greater than zero, but was %d.",
+			p_max_hits
+		)
+	);
+
+	space->try_optimize();
+
+	const JoltQueryFilter3D
+		query_filter(*this, p_collision_mask, p_collide_with_bodies, p_collide_with_areas);
+
+	const JPH::RVec3 from = to_jolt_r(p_from);
+	const JPH::RVec3 to = to_jolt_r(p_to);
+	const JPH::RRayCast ray(from, JPH::Vec3(to - from));
+
+	JoltRayQueryCollectorAllSorted collector(*space, p_max_hits);
+
+	space->get_narrow_phase_query().CastRay(
+		ray,
+		_make_ray_cast_settings(false, true),
+		collector,
+		query_filter,
+		query_filter,
+		query_filter
+	);
+
+	if (p_stop_at_body) {
+		collector.stop_at_body();
+	}
+
+	const int32_t hit_count = collector.get_hit_count();
+
+	PackedVector3Array positions;
+	PackedVector3Array normals;
+	PackedFloat32Array fractions;
+	PackedInt64Array collider_ids;
+	PackedInt32Array shapes;
+	PackedInt32Array face_indices;
+	Array rids;
+
+	positions.resize(hit_count);
+	normals.resize(hit_count);
+	fractions.resize(hit_count);
+	collider_ids.resize(hit_count);
+	shapes.resize(hit_count);
+	face_indices.resize(hit_count);
+	rids.resize(hit_count);
+
+	for (int32_t i = 0; i < hit_count; ++i) {
+		const JPH::RayCastResult& hit = collector.get_hit(i);
+
+		PhysicsServer3DExtensionRayResult result = {};
+		result.shape = -1;
+		result.face_index = -1;
+
+		_resolve_ray_hit(ray, hit, false, result);
+
+		positions[i] = result.position;
+		normals[i] = result.normal;
+		fractions[i] = hit.mFraction;
+		collider_ids[i] = (int64_t)result.collider_id;
+		shapes[i] = result.shape;
+		face_indices[i] = result.face_index;
+		rids[i] = result.rid;
+	}
+
+	Dictionary results;
+	results["position"] = positions;
+	results["normal"] = normals;
+	results["fraction"] = fractions;
+	results["collider_id"] = collider_ids;
+	results["rid"] = rids;
+	results["shape"] = shapes;
+	results["face_index"] = face_indices;
+
+	return results;
+}
+
+Dictionary JoltPhysicsDirectSpaceState3DExtension::intersect_shapes(
+	const RID& p_shape_rid,
+	const TypedArray<Transform3D>& p_transforms,
+	real_t p_margin,
+	uint32_t p_collision_mask,
+	bool p_collide_with_bodies,
+	bool p_collide_with_areas,
+	int32_t p_max_results
+) {
+	ENSURE_NOT_STEPPING_D();
+
+	ERR_FAIL_COND_D(p_max_results <= 0);
+
+	space->try_optimize();
+
+	JoltShapeImpl3D* shape = JoltPhysicsServer3DExtension::get_singleton()->get_shape(p_shape_rid);
+	ERR_FAIL_NULL_D(shape);
+
+	const JPH::ShapeRefC jolt_shape = shape->try_build();
+	ERR_FAIL_NULL_D(jolt_shape);
+
+	const auto query_count = (int32_t)p_transforms.size();
+
+	// The results of every query share a single buffer, which can't be more than `INT32_MAX` long.
+	const int64_t hit_capacity = (int64_t)query_count * p_max_results;
+
+	ERR_FAIL_COND_D_MSG(
+		hit_capacity > INT32_MAX,
+		vformat(
+			"Failed to intersect shapes. "
+			"The number of transforms (%d) times the maximum number of results (%d) is too large.",
+			query_count,
+			p_max_results
+		)
+	);
+
+	LocalVector<Transform3D> transforms;
+	transforms.resize(query_count);
+
+	for (int32_t i = 0; i < query_count; ++i) {
+		transforms[i] = p_transforms[i];
+	}
+
+	const JoltQueryFilter3D
+		query_filter(*this, p_collision_mask, p_collide_with_bodies, p_collide_with_areas);
+
+	LocalVector<PhysicsServer3DExtensionShapeResult> hits;
+	hits.resize((int32_t)hit_capacity);
+
+	PackedInt32Array hit_counts;
+	hit_counts.resize(query_count);
+	int32_t* hit_counts_ptr = hit_counts.ptrw();
+
+	space->run_jobs("Shape Intersections", query_count, 16, [&](int32_t p_begin, int32_t p_end) {
+		for (int32_t i = p_begin; i < p_end; ++i) {
+			Transform3D transform_com;
+			Vector3 scale;
+
+			decompose_query_transform(
+				jolt_shape,
+				transforms[i],
+				"intersect_shapes was passed an invalid transform.",
+				transform_com,
+				scale
+			);
+
+			hit_counts_ptr[i] = _intersect_shape_impl(
+				*jolt_shape,
+				transform_com,
+				scale,
+				(float)p_margin,
+				query_filter,
+				hits.ptr() + (ptrdiff_t)i * p_max_results,
+				p_max_results
+			);
+		}
+	});
+
+	Array rids;
+	PackedInt64Array collider_ids;
+	PackedInt32Array shapes;
+
+	for (int32_t i = 0; i < query_count; ++i) {
+		const PhysicsServer3DExtensionShapeResult* query_hits = hits.ptr() +
+			(ptrdiff_t)i * p_max_results;
+
+		for (int32_t j = 0; j < hit_counts_ptr[i]; ++j) {
+			const PhysicsServer3DExtensionShapeResult& hit = query_hits[j];
+
+			rids.push_back(hit.rid);
+			collider_ids.push_back((int64_t)hit.collider_id);
+			shapes.push_back(hit.shape);
+		}
+	}
+
+	Dictionary results;
+	results["hit_count"] = hit_counts;
+	results["rid"] = rids;
+	results["collider_id"] = collider_ids;
+	results["shape"] = shapes;
+
+	return results;
+}
+
+Dictionary JoltPhysicsDirectSpaceState3DExtension::cast_motions(
+	const RID& p_shape_rid,
+	const TypedArray<Transform3D>& p_transforms,
+	const PackedVector3Array& p_motions,
+	real_t p_margin,
+	uint32_t p_collision_mask,
+	bool p_collide_with_bodies,
+	bool p_collide_with_areas
+) {
+	ENSURE_NOT_STEPPING_D();
+
+	const auto query_count = (int32_t)p_motions.size();
+	const auto transform_count = (int32_t)p_transforms.size();
+
+	ERR_FAIL_COND_D_MSG(
+		transform_count != 1 && transform_count != query_count,
+		vformat(
+			"Failed to cast motions. "
+			"The number of transforms (%d) must either be 1 or match the number of motions (%d).",
+			transform_count,
+			query_count
+		)
+	);
+
+	space->try_optimize();
+
+	JoltShapeImpl3D* shape = JoltPhysicsServer3DExtension::get_singleton()->get_shape(p_shape_rid);
+	ERR_FAIL_NULL_D(shape);
+
+	const JPH::ShapeRefC jolt_shape = shape->try_build();
+	ERR_FAIL_NULL_D(jolt_shape);
+
+	LocalVector<Transform3D> transforms;
+	transforms.resize(transform_count);
+
+	for (int32_t i = 0; i < transform_count; ++i) {
+		transforms[i] = p_transforms[i];
+	}
+
+	JPH::CollideShapeSettings settings;
+	settings.mMaxSeparationDistance = (float)p_margin;
+
+	const JoltQueryFilter3D
+		query_filter(*this, p_collision_mask, p_collide_with_bodies, p_collide_with_areas);
+
+	const bool use_edge_removal = JoltProjectSettings::use_edge_removal_for_queries();
+
+	PackedFloat32Array safe_fractions;
+	PackedFloat32Array unsafe_fractions;
+
+	safe_fractions.resize(query_count);
+	unsafe_fractions.resize(query_count);
+
+	const Vector3* motions_ptr = p_motions.ptr();
+	float* safe_fractions_ptr = safe_fractions.ptrw();
+	float* unsafe_fractions_ptr = unsafe_fractions.ptrw();
+
+	space->run_jobs("Shape Casts", query_count, 8, [&](int32_t p_begin, int32_t p_end) {
+		for (int32_t i = p_begin; i < p_end; ++i) {
+			Transform3D transform_com;
+			Vector3 scale;
+
+			decompose_query_transform(
+				jolt_shape,
+				transforms[transform_count == 1 ? 0 : i],
+				"cast_motions was passed an invalid transform.",
+				transform_com,
+				scale
+			);
+
+			real_t closest_safe = 1.0f;
+			real_t closest_unsafe = 1.0f;
+
+			_cast_motion_impl(
+				*jolt_shape,
+				transform_com,
+				scale,
+				motions_ptr[i],
+				use_edge_removal,
+				true,
+				settings,
+				query_filter,
+				query_filter,
+				query_filter,
+				JPH::ShapeFilter(),
+				closest_safe,
+				closest_unsafe
+			);
+
+			safe_fractions_ptr[i] = (float)closest_safe;
+			unsafe_fractions_ptr[i] = (float)closest_unsafe;
+		}
+	});
+
+	Dictionary results;
+	results["safe_fraction"] = safe_fractions;
+	results["unsafe_fraction"] = unsafe_fractions;
+
+	return results;
+}
+
+Dictionary JoltPhysicsDirectSpaceState3DExtension::collide_shapes(
+	const RID& p_shape_rid,
+	const TypedArray<Transform3D>& p_transforms,
+	real_t p_margin,
+	uint32_t p_collision_mask,
+	bool p_collide_with_bodies,
+	bool p_collide_with_areas,
+	int32_t p_max_results
+) {
+	ENSURE_NOT_STEPPING_D();
+
+	ERR_FAIL_COND_D(p_max_results <= 0);
+
+	space->try_optimize();
+
+	JoltShapeImpl3D* shape = JoltPhysicsServer3DExtension::get_singleton()->get_shape(p_shape_rid);
+	ERR_FAIL_NULL_D(shape);
+
+	const JPH::ShapeRefC jolt_shape = shape->try_build();
+	ERR_FAIL_NULL_D(jolt_shape);
+
+	const auto query_count = (int32_t)p_transforms.size();
+
+	// Every contact is made up of two points, and the points of every query share a single buffer,
+	// which can't be more than `INT32_MAX` long.
+	const int64_t point_capacity = (int64_t)query_count * p_max_results * 2;
+
+	ERR_FAIL_COND_D_MSG(
+		p_max_results > INT32_MAX / 2 || point_capacity > INT32_MAX,
+		vformat(
+			"Failed to collide shapes. "
+			"The number of transforms (%d) times the maximum number of results (%d) is too large.",
+			query_count,
+			p_max_results
+		)
+	);
+
+	LocalVector<Transform3D> transforms;
+	transforms.resize(query_count);
+
+	for (int32_t i = 0; i < query_count; ++i) {
+		transforms[i] = p_transforms[i];
+	}
+
+	const JoltQueryFilter3D
+		query_filter(*this, p_collision_mask, p_collide_with_bodies, p_collide_with_areas);
+
+	const int32_t max_points = p_max_results * 2;
+
+	LocalVector<Vector3> points;
+	points.resize((int32_t)point_capacity);
+
+	PackedInt32Array contact_counts;
+	contact_counts.resize(query_count);
+	int32_t* contact_counts_ptr = contact_counts.ptrw();
+
+	space->run_jobs("Shape Collisions", query_count, 16, [&](int32_t p_begin, int32_t p_end) {
+		for (int32_t i = p_begin; i < p_end; ++i) {
+			Transform3D transform_com;
+			Vector3 scale;
+
+			decompose_query_transform(
+				jolt_shape,
+				transforms[i],
+				"collide_shapes was passed an invalid transform.",
+				transform_com,
+				scale
+			);
+
+			_collide_shape_impl(
+				*jolt_shape,
+				transform_com,
+				scale,
+				(float)p_margin,
+				query_filter,
+				points.ptr() + (ptrdiff_t)i * max_points,
+				p_max_results,
+				contact_counts_ptr[i]
+			);
+		}
+	});
+
+	PackedVector3Array contact_points;
+
+	for (int32_t i = 0; i < query_count; ++i) {
+		const Vector3* query_points = points.ptr() + (ptrdiff_t)i * max_points;
+
+		for (int32_t j = 0; j < contact_counts_ptr[i] * 2; ++j) {
+			contact_points.push_back(query_points[j]);
+		}
+	}
+
+	Dictionary results;
+	results["contact_count"] = contact_counts;
+	results["points"] = contact_points;
+
+	return results;
+}
+
+bool JoltPhysicsDirectSpaceState3DExtension::test_body_motion(
+	const JoltBodyImpl3D& p_body,
+	const Transform3D& p_transform,
+	const Vector3& p_motion,
+	float p_margin,
+	int32_t p_max_collisions,
+	bool p_collide_separation_ray,
+	bool p_recovery_as_collision,
+	PhysicsServer3DExtensionMotionResult* p_result
+) const {
+	ENSURE_NOT_STEPPING_D();
+
+	space->try_optimize();
+
+	return _test_body_motion_impl(
+		p_body,
+		p_transform,
+		p_motion,
+		p_margin,
+		p_max_collisions,
+		p_collide_separation_ray,
+		p_recovery_as_collision,
+		p_result
+	);
+}
+
+Dictionary JoltPhysicsDirectSpaceState3DExtension::test_body_motions(
+	const JoltBodyImpl3D* const* p_bodies,
+	int32_t p_body_count,
+	const TypedArray<Transform3D>& p_transforms,
+	const PackedVector3Array& p_motions,
+	float p_margin,
+	int32_t p_max_collisions,
+	bool p_collide_separation_ray,
+	bool p_recovery_as_collision
+) const {
+	ENSURE_NOT_STEPPING_D();
+
+	ERR_FAIL_COND_D_MSG(
+		p_transforms.size() != p_body_count || p_motions.size() != p_body_count,
+		vformat(
+			"Failed to test body motions. "
+			"The number of transforms (%d) and motions (%d) must match the number of bodies (%d).",
+			p_transforms.size(),
+			p_motions.size(),
+			p_body_count
+		)
+	);
+
+	space->try_optimize();
+
+	LocalVector<Transform3D> transforms;
+	transforms.resize(p_body_count);
+
+	for (int32_t i = 0; i < p_body_count; ++i) {
+		transforms[i] = p_transforms[i];
+	}
+
+	LocalVector<PhysicsServer3DExtensionMotionResult> motion_results;
+	motion_results.resize(p_body_count);
+
+	const Vector3* motions_ptr = p_motions.ptr();
+
+	space->run_jobs("Body Motions", p_body_count, 4, [&](int32_t p_begin, int32_t p_end) {
+		for (int32_t i = p_begin; i < p_end; ++i) {
+			_test_body_motion_impl(
+				*p_bodies[i],
+				transforms[i],
+				motions_ptr[i],
+				p_margin,
+				p_max_collisions,
+				p_collide_separation_ray,
+				p_recovery_as_collision,
+				&motion_results[i]
+			);
+		}
+	});
+
+	PackedVector3Array travels;
+	PackedVector3Array remainders;
+	PackedFloat32Array safe_fractions;
+	PackedFloat32Array unsafe_fractions;
+	PackedInt32Array collision_counts;
+
+	travels.resize(p_body_count);
+	remainders.resize(p_body_count);
+	safe_fractions.resize(p_body_count);
+	unsafe_fractions.resize(p_body_count);
+	collision_counts.resize(p_body_count);
+
+	PackedVector3Array positions;
+	PackedVector3Array normals;
+	PackedVector3Array collider_velocities;
+	PackedFloat32Array depths;
+	PackedInt64Array collider_ids;
+	Array colliders;
+	PackedInt32Array collider_shapes;
+	PackedInt32Array local_shapes;
+
+	for (int32_t i = 0; i < p_body_count; ++i) {
+		const PhysicsServer3DExtensionMotionResult& motion_result = motion_results[i];
+
+		travels[i] = motion_result.travel;
+		remainders[i] = motion_result.remainder;
+		safe_fractions[i] = (float)motion_result.collision_safe_fraction;
+		unsafe_fractions[i] = (float)motion_result.collision_unsafe_fraction;
+		collision_counts[i] = motion_result.collision_count;
+
+		for (int32_t j = 0; j < motion_result.collision_count; ++j) {
+			const PhysicsServer3DExtensionMotionCollision& collision = motion_result.collisions[j];
+
+			positions.push_back(collision.position);
+			normals.push_back(collision.normal);
+			collider_velocities.push_back(collision.collider_velocity);
+			depths.push_back((float)collision.depth);
+			collider_ids.push_back((int64_t)collision.collider_id);
+			colliders.push_back(collision.collider);
+			collider_shapes.push_back(collision.collider_shape);
+			local_shapes.push_back(collision.local_shape);
+		}
+	}
+
+	Dictionary results;
+	results["travel"] = travels;
+	results["remainder"] = remainders;
+	results["safe_fraction"] = safe_fractions;
+	results["unsafe_fraction"] = unsafe_fractions;
+	results["collision_count"] = collision_counts;
+	results["position"] = positions;
+	results["normal"] = normals;
+	results["collider_velocity"] = collider_velocities;
+	results["depth"] = depths;
+	results["collider_id"] = collider_ids;
+	results["collider"] = colliders;
+	results["collider_shape"] = collider_shapes;
+	results["local_shape"] = local_shapes;
+
+	return results;
+}
+
+int64_t JoltPhysicsDirectSpaceState3DExtension::intersect_ray_async(
+	const Vector3& p_from,
+	const Vector3& p_to,
+	uint32_t p_collision_mask,
+	bool p_collide_with_bodies,
+	bool p_collide_with_areas,
+	bool p_hit_from_inside,
+	bool p_hit_back_faces
+) {
+	auto* query = memnew(JoltQueryImpl3D(JoltPhysicsServer3DExtension::QUERY_TYPE_RAY));
+
+	query->set_transform(Transform3D(Basis(), p_from));
+	query->set_target_position(p_to - p_from);
+	query->set_collision_mask(p_collision_mask);
+	query->set_jolt_flag(
+		JoltPhysicsServer3DExtension::QUERY_FLAG_COLLIDE_WITH_BODIES,
+		p_collide_with_bodies
+	);
+	query->set_jolt_flag(
+		JoltPhysicsServer3DExtension::QUERY_FLAG_COLLIDE_WITH_AREAS,
+		p_collide_with_areas
+	);
+	query->set_jolt_flag(
+		JoltPhysicsServer3DExtension::QUERY_FLAG_HIT_FROM_INSIDE,
+		p_hit_from_inside
+	);
+	query->set_jolt_flag(JoltPhysicsServer3DExtension::QUERY_FLAG_HIT_BACK_FACES, p_hit_back_faces);
+
+	return space->submit_async_query(query);
+}
+
+int64_t JoltPhysicsDirectSpaceState3DExtension::cast_motion_async(
+	const RID& p_shape_rid,
+	const Transform3D& p_transform,
+	const Vector3& p_motion,
+	real_t p_margin,
+	uint32_t p_collision_mask,
+	bool p_collide_with_bodies,
+	bool p_collide_with_areas
+) {
+	JoltShapeImpl3D* shape = JoltPhysicsServer3DExtension::get_singleton()->get_shape(p_shape_rid);
+	ERR_FAIL_NULL_D(shape);
+
+	auto* query = memnew(JoltQueryImpl3D(JoltPhysicsServer3DExtension::QUERY_TYPE_SHAPE_CAST));
+
+	query->set_shape(shape);
+	query->set_transform(p_transform);
+	query->set_target_position(p_transform.basis.inverse().xform(p_motion));
+	query->set_margin((float)p_margin);
+	query->set_collision_mask(p_collision_mask);
+	query->set_jolt_flag(
+		JoltPhysicsServer3DExtension::QUERY_FLAG_COLLIDE_WITH_BODIES,
+		p_collide_with_bodies
+	);
+	query->set_jolt_flag(
+		JoltPhysicsServer3DExtension::QUERY_FLAG_COLLIDE_WITH_AREAS,
+		p_collide_with_areas
+	);
+
+	return space->submit_async_query(query);
+}
+
+bool JoltPhysicsDirectSpaceState3DExtension::is_async_result_ready(int64_t p_ticket) const {
+	return space->is_async_query_ready(p_ticket);
+}
+
+Dictionary JoltPhysicsDirectSpaceState3DExtension::take_async_result(int64_t p_ticket) {
+	JoltQueryImpl3D* query = space->take_async_query(p_ticket);
+
+	ERR_FAIL_NULL_D_MSG(
+		query,
+		vformat(
+			"Failed to take result of asynchronous query with ticket '%d'. "
+			"The query has either not finished yet, its result has already been taken, or its "
+			"result was discarded after not being taken for too long.",
+			p_ticket
+		)
+	);
+
+	const Dictionary result = query->get_result();
+
+	memdelete_safely(query);
+
+	return result;
+}
+
+Dictionary JoltPhysicsDirectSpaceState3DExtension::get_query_cache_stats() const {
+	const MutexLock lock(query_cache_mutex);
+
+	const int64_t lookups = query_cache_hits + query_cache_misses;
+
+	Dictionary stats;
+	stats["hits"] = query_cache_hits;
+	stats["misses"] = query_cache_misses;
+	stats["hit_rate"] = lookups > 0 ? (double)query_cache_hits / (double)lookups : 0.0;
+	stats["entries"] = query_cache.size();
+
+	return stats;
+}
+
+void JoltPhysicsDirectSpaceState3DExtension::reset_query_cache_stats() {
+	const MutexLock lock(query_cache_mutex);
+
+	query_cache_hits = 0;
+	query_cache_misses = 0;
+}
+
+bool JoltPhysicsDirectSpaceState3DExtension::cast_ray(
+	const Vector3& p_from,
+	const Vector3& p_to,
+	const JoltQueryFilter3D& p_query_filter,
+	bool p_hit_from_inside,
+	bool p_hit_back_faces,
+	PhysicsServer3DExtensionRayResult& p_result
+) const {
+	const JPH::RVec3 from = to_jolt_r(p_from);
+	const JPH::RVec3 to = to_jolt_r(p_to);
+	const JPH::RRayCast ray(from, JPH::Vec3(to - from));
+
+	return _cast_ray(
+		ray,
+		_make_ray_cast_settings(p_hit_from_inside, p_hit_back_faces),
+		p_query_filter,
+		p_hit_from_inside,
+		p_result
+	);
+}
+
+bool JoltPhysicsDirectSpaceState3DExtension::cast_shape(
+	const JPH::Shape& p_jolt_shape,
+	const Transform3D& p_transform,
+	const Vector3& p_motion,
+	float p_margin,
+	const JoltQueryFilter3D& p_query_filter,
+	real_t& p_closest_safe,
+	real_t& p_closest_unsafe,
+	PhysicsServer3DExtensionShapeRestInfo& p_info
+) const {
+	Transform3D transform_com;
+	Vector3 scale;
+
+	decompose_query_transform(
+		&p_jolt_shape,
+		p_transform,
+		"cast_shape was passed an invalid transform.",
+		transform_com,
+		scale
+	);
+
+	JPH::CollideShapeSettings settings;
+	settings.mMaxSeparationDistance = p_margin;
+
+	_cast_motion_impl(
+		p_jolt_shape,
+		transform_com,
+		scale,
+		p_motion,
+		JoltProjectSettings::use_edge_removal_for_queries(),
+		true,
+		settings,
+		p_query_filter,
+		p_query_filter,
+		p_query_filter,
+		JPH::ShapeFilter(),
+		p_closest_safe,
+		p_closest_unsafe
+	);
+
+	// Much like `ShapeCast3D` we look for the actual collision at the unsafe fraction of the
+	// motion, which also picks up anything we were already overlapping with before moving.
+	return _rest_info_impl(
+		p_jolt_shape,
+		transform_com.translated(p_motion * p_closest_unsafe),
+		scale,
+		p_margin,
+		p_query_filter,
+		p_info
+	);
+}
+
+bool JoltPhysicsDirectSpaceState3DExtension::_test_body_motion_impl(
+	const JoltBodyImpl3D& p_body,
+	const Transform3D& p_transform,
+	const Vector3& p_motion,
+	float p_margin,
+	int32_t p_max_collisions,
+	bool p_collide_separation_ray,
+	bool p_recovery_as_collision,
+	PhysicsServer3DExtensionMotionResult* p_result
+) const {
+	p_margin = MAX(p_margin, 0.0001f);
+	p_max_collisions = MIN(p_max_collisions, 32);
+
+	Transform3D transform = p_transform;
+
+	ENSURE_SCALE_NOT_ZERO(
+		transform,
+		vformat(
+			"body_test_motion was passed an invalid transform along with body '%s'.",
+			p_body.to_string()
+		)
+	);
+
+	Vector3 scale;
+	Math::decompose(transform, scale);
+
+	Vector3 recovery;
+	const bool recovered = _body_motion_recover(p_body, transform, p_margin, recovery);
+
+	transform.origin += recovery;
+
+	real_t safe_fraction = 1.0;
+	real_t unsafe_fraction = 1.0;
+
+	const bool hit = _body_motion_cast(
+		p_body,
+		transform,
+		scale,
+		p_motion,
+		p_collide_separation_ray,
+		safe_fraction,
+		unsafe_fraction
+	);
+
+	bool collided = false;
+
+	if (hit || (recovered && p_recovery_as_collision)) {
+		collided = _body_motion_collide(
+			p_body,
+			transform.translated(p_motion * unsafe_fraction),
+			p_motion,
+			p_margin,
+			p_max_collisions,
+			p_result
+		);
+	}
+
+	if (p_result == nullptr) {
+		return collided;
+	}
+
+	if (collided) {
+		const PhysicsServer3DExtensionMotionCollision& deepest = p_result->collisions[0];
+
+		p_result->travel = recovery + p_motion * safe_fraction;
+		p_result->remainder = p_motion - p_motion * safe_fraction;
+		p_result->collision_depth = deepest.depth;
+		p_result->collision_safe_fraction = safe_fraction;
+		p_result->collision_unsafe_fraction = unsafe_fraction;
+	} else {
+		p_result->travel = recovery + p_motion;
+		p_result->remainder = Vector3();
+		p_result->collision_depth = 0.0f;
+		p_result->collision_safe_fraction = 1.0f;
+		p_result->collision_unsafe_fraction = 1.0f;
+		p_result->collision_count = 0;
+	}
+
+	return collided;
+}
+
+JPH::RayCastSettings JoltPhysicsDirectSpaceState3DExtension::_make_ray_cast_settings(
+	bool p_hit_from_inside,
+	bool p_hit_back_faces
+) {
+	const JPH::EBackFaceMode back_face_mode = p_hit_back_faces
+		? JPH::EBackFaceMode::CollideWithBackFaces
+		: JPH::EBackFaceMode::IgnoreBackFaces;
+
+	JPH::RayCastSettings settings;
+	settings.mTreatConvexAsSolid = p_hit_from_inside;
+	settings.mBackFaceModeTriangles = back_face_mode;
+
+	if (JoltProjectSettings::use_legacy_ray_casting()) {
+		settings.mBackFaceModeConvex = back_face_mode;
+	}
+
+	return settings;
+}
+
+bool JoltPhysicsDirectSpaceState3DExtension::_cast_ray(
+	const JPH::RRayCast& p_ray,
+	const JPH::RayCastSettings& p_settings,
+	const JoltQueryFilter3D& p_query_filter,
+	bool p_hit_from_inside,
+	PhysicsServer3DExtensionRayResult& p_result
+) const {
+	JoltQueryCollectorClosest<JPH::CastRayCollector> collector;
+
+	space->get_narrow_phase_query().CastRay(
+		p_ray,
+		p_settings,
+		collector,
+		p_query_filter,
+		p_query_filter,
+		p_query_filter
+	);
+
+	if (!collector.had_hit()) {
+		return false;
+	}
+
+	return _resolve_ray_hit(p_ray, collector.get_hit(), p_hit_from_inside, p_result);
+}
+
+bool JoltPhysicsDirectSpaceState3DExtension::_resolve_ray_hit(
+	const JPH::RRayCast& p_ray,
+	const JPH::RayCastResult& p_hit,
+	bool p_hit_from_inside,
+	PhysicsServer3DExtensionRayResult& p_result
+) const {
+	const JPH::BodyID& body_id = p_hit.mBodyID;
+	const JPH::SubShapeID& sub_shape_id = p_hit.mSubShapeID2;
+
+	const JoltReadableBody3D body = space->read_body(body_id);
+	const JoltObjectImpl3D* object = body.as_object();
+	ERR_FAIL_NULL_D(object);
+
+	const JPH::RVec3 position = p_ray.GetPointOnRay(p_hit.mFraction);
+
+	JPH::Vec3 normal = JPH::Vec3::sZero();
+
+	if (!p_hit_from_inside || p_hit.mFraction > 0.0f) {
+		normal = body->GetWorldSpaceSurfaceNormal(sub_shape_id, position);
+
+		// HACK(mihe): If we got a back-face normal we need to flip it
+		if (normal.Dot(p_ray.mDirection) > 0) {
+			normal = -normal;
+		}
+	}
+
+	p_result.position = to_godot(position);
+	p_result.normal = to_godot(normal);
+	p_result.rid = object->get_rid();
+	p_result.collider_id = object->get_instance_id();
+	p_result.collider = object->get_instance_unsafe();
+	p_result.shape = 0;
+
+	if (const JoltShapedObjectImpl3D* shaped_object = object->as_shaped()) {
+		const int32_t shape_index = shaped_object->find_shape_index(sub_shape_id);
+		ERR_FAIL_COND_D(shape_index == -1);
+		p_result.shape = shape_index;
+		p_result.face_index = _try_get_face_index(*body, sub_shape_id);
+	}
+
+	return true;
+}
+
+int32_t JoltPhysicsDirectSpaceState3DExtension::_intersect_shape_impl(
+	const JPH::Shape& p_jolt_shape,
+	const Transform3D& p_transform_com,
+	const Vector3& p_scale,
+	float p_margin,
+	const JoltQueryFilter3D& p_query_filter,
+	PhysicsServer3DExtensionShapeResult* p_results,
+	int32_t p_max_results
+) const {
+	JoltShapeQueryCollectorAnyMultiScratch collector(p_max_results);
+
+	_collect_shape_hits(
+		p_jolt_shape,
+		p_transform_com,
+		p_scale,
+		p_margin,
+		p_query_filter,
+		collector
+	);
+
+	return resolve_shape_results(*space, collector, p_results);
+}
+
+void JoltPhysicsDirectSpaceState3DExtension::_collect_shape_hits(
+	const JPH::Shape& p_jolt_shape,
+	const Transform3D& p_transform_com,
+	const Vector3& p_scale,
+	float p_margin,
+	const JoltQueryFilter3D& p_query_filter,
+	JPH::CollideShapeCollector& p_collector
+) const {
+	JPH::CollideShapeSettings settings;
+	settings.mMaxSeparationDistance = p_margin;
+
+	_collide_shape_queries(
+		&p_jolt_shape,
+		to_jolt(p_scale),
+		to_jolt_r(p_transform_com),
+		settings,
+		to_jolt_r(p_transform_com.origin),
+		p_collector,
+		p_query_filter,
+		p_query_filter,
+		p_query_filter
+	);
+}
+
+int32_t JoltPhysicsDirectSpaceState3DExtension::_intersect_cached(
+	const QueryCacheKey& p_key,
+	PhysicsServer3DExtensionShapeResult* p_results,
+	int32_t p_max_results
+) {
+	MutexLock lock(query_cache_mutex);
+
+	const uint64_t current_version = space->get_query_cache_version();
+
+	if (query_cache_version != current_version) {
+		query_cache.clear();
+		query_cache_version = current_version;
+	}
+
+	if (const ShapeResults* cached_results = query_cache.getptr(p_key)) {
+		query_cache_hits += 1;
+		return _copy_cached_results(*cached_results, p_results, p_max_results);
+	}
+
+	query_cache_misses += 1;
+
+	// We let go of the lock while querying, so that concurrent queries don't end up serialized on
+	// the cache, at the risk of the occasional identical query being performed more than once.
+	lock.unlock();
+
+	ShapeResults new_results;
+	_intersect_uncached(p_key, new_results);
+
+	const int32_t result_count = _copy_cached_results(new_results, p_results, p_max_results);
+
+	lock.lock();
+
+	if (query_cache_version == current_version) {
+		query_cache.insert(p_key, std::move(new_results));
+	}
+
+	return result_count;
+}
+
+void JoltPhysicsDirectSpaceState3DExtension::_intersect_uncached(
+	const QueryCacheKey& p_key,
+	ShapeResults& p_results
+) const {
+	// The cached results need to be usable with any exclusion list and any maximum number of
+	// results, so we gather every hit here and leave it to `_copy_cached_results` to narrow down.
+	JoltQueryFilter3D query_filter(
+		*this,
+		p_key.collision_mask,
+		p_key.collide_with_bodies,
+		p_key.collide_with_areas
+	);
+
+	query_filter.set_use_query_exclusions(false);
+
+	if (p_key.jolt_shape == nullptr) {
+		JoltQueryCollectorAnyMultiScratch<JPH::CollidePointCollector> collector;
+
+		space->get_narrow_phase_query().CollidePoint(
+			to_jolt_r(p_key.transform.origin),
+			collector,
+			query_filter,
+			query_filter,
+			query_filter
+		);
+
+		p_results.resize(collector.get_hit_count());
+		p_results.resize(resolve_shape_results(*space, collector, p_results.ptr()));
+	} else {
+		Transform3D transform_com;
+		Vector3 scale;
+
+		decompose_query_transform(
+			p_key.jolt_shape,
+			p_key.transform,
+			"intersect_shape was passed an invalid transform.",
+			transform_com,
+			scale
+		);
+
+		JoltShapeQueryCollectorAnyMultiScratch collector;
+
+		_collect_shape_hits(
+			*p_key.jolt_shape,
+			transform_com,
+			scale,
+			(float)p_key.margin,
+			query_filter,
+			collector
+		);
+
+		p_results.resize(collector.get_hit_count());
+		p_results.resize(resolve_shape_results(*space, collector, p_results.ptr()));
+	}
+}
+
+int32_t JoltPhysicsDirectSpaceState3DExtension::_copy_cached_results(
+	const ShapeResults& p_cached_results,
+	PhysicsServer3DExtensionShapeResult* p_results,
+	int32_t p_max_results
+) const {
+	int32_t result_count = 0;
+
+	for (const PhysicsServer3DExtensionShapeResult& cached_result : p_cached_results) {
+		if (result_count == p_max_results) {
 			break;
 		}
 
-		if (distance_sq < closest_distance_sq) {
-			closest_distance_sq = distance_sq;
-			closest_point = shape_4x4 * point_on_a;
-			found_point = true;
+		if (!is_body_excluded_from_query(cached_result.rid)) {
+			p_results[result_count++] = cached_result;
 		}
 	}
 
-	if (found_point) {
-		return to_godot(closest_point);
-	} else {
-		return to_godot(body->GetPosition());
-	}
+	return result_count;
 }
 
-bool JoltPhysicsDirectSpaceState3DExtension::test_body_motion(
-	const JoltBodyImpl3D& p_body,
-	const Transform3D& p_transform,
-	const Vector3& p_motion,
+bool JoltPhysicsDirectSpaceState3DExtension::_collide_shape_impl(
+	const JPH::Shape& p_jolt_shape,
+	const Transform3D& p_transform_com,
+	const Vector3& p_scale,
 	float p_margin,
-	int32_t p_max_collisions,
-	bool p_collide_separation_ray,
-	bool p_recovery_as_collision,
-	PhysicsServer3DExtensionMotionResult* p_result
+	const JoltQueryFilter3D& p_query_filter,
+	Vector3* p_points,
+	int32_t p_max_results,
+	int32_t& p_result_count
 ) const {
-	p_margin = MAX(p_margin, 0.0001f);
-	p_max_collisions = MIN(p_max_collisions, 32);
+	p_result_count = 0;
 
-	Transform3D transform = p_transform;
+	JPH::CollideShapeSettings settings;
+	settings.mCollectFacesMode = JPH::ECollectFacesMode::CollectFaces;
+	settings.mMaxSeparationDistance = p_margin;
 
-	ENSURE_SCALE_NOT_ZERO(
-		transform,
-		vformat(
-			"body_test_motion was passed an invalid transform along with body '%s'.",
-			p_body.to_string()
-		)
-	);
+	const Vector3& base_offset = p_transform_com.origin;
 
-	Vector3 scale;
-	Math::decompose(transform, scale);
+	JoltShapeQueryCollectorAnyMulti<32> collector(p_max_results);
 
-	space->try_optimize();
+	_collide_shape_queries(
+		&p_jolt_shape,
+		to_jolt(p_scale),
+		to_jolt_r(p_transform_com),
+		settings,
+		to_jolt_r(base_offset),
+		collector,
+		p_query_filter,
+		p_query_filter,
+		p_query_filter
+	);
 
-	Vector3 recovery;
-	const bool recovered = _body_motion_recover(p_body, transform, p_margin, recovery);
+	if (!collector.had_hit()) {
+		return false;
+	}
 
-	transform.origin += recovery;
+	const int32_t max_points = p_max_results * 2;
 
-	real_t safe_fraction = 1.0;
-	real_t unsafe_fraction = 1.0;
+	int32_t point_count = 0;
 
-	const bool hit = _body_motion_cast(
-		p_body,
-		transform,
-		scale,
-		p_motion,
-		p_collide_separation_ray,
-		safe_fraction,
-		unsafe_fraction
-	);
+	for (int32_t i = 0; i < collector.get_hit_count(); ++i) {
+		const JPH::CollideShapeResult& hit = collector.get_hit(i);
 
-	bool collided = false;
+		const Vector3 penetration_axis = to_godot(hit.mPenetrationAxis.Normalized());
+		const Vector3 margin_offset = penetration_axis * p_margin;
 
-	if (hit || (recovered && p_recovery_as_collision)) {
-		collided = _body_motion_collide(
-			p_body,
-			transform.translated(p_motion * unsafe_fraction),
-			p_motion,
-			p_margin,
-			p_max_collisions,
-			p_result
+		JPH::ContactPoints contact_points1;
+		JPH::ContactPoints contact_points2;
+
+		_generate_manifold(
+			hit,
+			contact_points1,
+			contact_points2
+#ifdef JPH_DEBUG_RENDERER
+			,
+			to_jolt_r(base_offset)
+#endif // JPH_DEBUG_RENDERER
 		);
+
+		for (JPH::uint j = 0; j < contact_points1.size(); ++j) {
+			p_points[point_count++] = base_offset + to_godot(contact_points1[j]) + margin_offset;
+			p_points[point_count++] = base_offset + to_godot(contact_points2[j]);
+
+			if (point_count >= max_points) {
+				break;
+			}
+		}
+
+		if (point_count >= max_points) {
+			break;
+		}
 	}
 
-	if (p_result == nullptr) {
-		return collided;
+	p_result_count = point_count / 2;
+
+	return true;
+}
+
+bool JoltPhysicsDirectSpaceState3DExtension::_rest_info_impl(
+	const JPH::Shape& p_jolt_shape,
+	const Transform3D& p_transform_com,
+	const Vector3& p_scale,
+	float p_margin,
+	const JoltQueryFilter3D& p_query_filter,
+	PhysicsServer3DExtensionShapeRestInfo& p_info
+) const {
+	JPH::CollideShapeSettings settings;
+	settings.mMaxSeparationDistance = p_margin;
+
+	const Vector3& base_offset = p_transform_com.origin;
+
+	JoltShapeQueryCollectorClosest collector;
+
+	_collide_shape_queries(
+		&p_jolt_shape,
+		to_jolt(p_scale),
+		to_jolt_r(p_transform_com),
+		settings,
+		to_jolt_r(base_offset),
+		collector,
+		p_query_filter,
+		p_query_filter,
+		p_query_filter
+	);
+
+	if (!collector.had_hit()) {
+		return false;
 	}
 
-	if (collided) {
-		const PhysicsServer3DExtensionMotionCollision& deepest = p_result->collisions[0];
+	const JPH::CollideShapeResult& hit = collector.get_hit();
 
-		p_result->travel = recovery + p_motion * safe_fraction;
-		p_result->remainder = p_motion - p_motion * safe_fraction;
-		p_result->collision_depth = deepest.depth;
-		p_result->collision_safe_fraction = safe_fraction;
-		p_result->collision_unsafe_fraction = unsafe_fraction;
-	} else {
-		p_result->travel = recovery + p_motion;
-		p_result->remainder = Vector3();
-		p_result->collision_depth = 0.0f;
-		p_result->collision_safe_fraction = 1.0f;
-		p_result->collision_unsafe_fraction = 1.0f;
-		p_result->collision_count = 0;
+	const JoltReadableBody3D body = space->read_body(hit.mBodyID2);
+	const JoltObjectImpl3D* object = body.as_object();
+	ERR_FAIL_NULL_D(object);
+
+	const Vector3 hit_point = base_offset + to_godot(hit.mContactPointOn2);
+
+	p_info.point = hit_point;
+	p_info.normal = to_godot(-hit.mPenetrationAxis.Normalized());
+	p_info.rid = object->get_rid();
+	p_info.collider_id = object->get_instance_id();
+	p_info.shape = 0;
+	p_info.linear_velocity = object->get_velocity_at_position(hit_point);
+
+	if (const JoltShapedObjectImpl3D* shaped_object = object->as_shaped()) {
+		const int32_t shape_index = shaped_object->find_shape_index(hit.mSubShapeID2);
+		ERR_FAIL_COND_D(shape_index == -1);
+		p_info.shape = shape_index;
 	}
 
-	return collided;
+	return true;
 }
 
 bool JoltPhysicsDirectSpaceState3DExtension::_cast_motion_impl(
@@ -716,6 +1935,24 @@ bool JoltPhysicsDirectSpaceState3DExtension::_cast_motion_impl(
 		return false;
 	}
 
+	if (motion_length > 0.0f && JoltProjectSettings::use_swept_shape_casting()) {
+		return _cast_motion_swept(
+			p_jolt_shape,
+			p_transform_com,
+			p_scale,
+			p_motion,
+			p_use_edge_removal,
+			p_ignore_overlaps,
+			p_settings,
+			p_broad_phase_layer_filter,
+			p_object_layer_filter,
+			p_body_filter,
+			p_shape_filter,
+			p_closest_safe,
+			p_closest_unsafe
+		);
+	}
+
 	const JPH::RMat44 transform_com = to_jolt_r(p_transform_com);
 	const JPH::Vec3 scale = to_jolt(p_scale);
 	const JPH::Vec3 motion = to_jolt(p_motion);
@@ -726,7 +1963,7 @@ bool JoltPhysicsDirectSpaceState3DExtension::_cast_motion_impl(
 	aabb_translated.Translate(motion);
 	aabb.Encapsulate(aabb_translated);
 
-	JoltQueryCollectorAnyMulti<JPH::CollideShapeBodyCollector, 2048> aabb_collector;
+	JoltQueryCollectorAnyMultiScratch<JPH::CollideShapeBodyCollector> aabb_collector;
 
 	space->get_broad_phase_query().CollideAABox(
 		aabb,
@@ -847,6 +2084,117 @@ bool JoltPhysicsDirectSpaceState3DExtension::_cast_motion_impl(
 	return collided;
 }
 
+bool JoltPhysicsDirectSpaceState3DExtension::_cast_motion_swept(
+	const JPH::Shape& p_jolt_shape,
+	const Transform3D& p_transform_com,
+	const Vector3& p_scale,
+	const Vector3& p_motion,
+	bool p_use_edge_removal,
+	bool p_ignore_overlaps,
+	const JPH::CollideShapeSettings& p_settings,
+	const JPH::BroadPhaseLayerFilter& p_broad_phase_layer_filter,
+	const JPH::ObjectLayerFilter& p_object_layer_filter,
+	const JPH::BodyFilter& p_body_filter,
+	const JPH::ShapeFilter& p_shape_filter,
+	real_t& p_closest_safe,
+	real_t& p_closest_unsafe
+) const {
+	const auto motion_length = (float)p_motion.length();
+	const float margin = p_settings.mMaxSeparationDistance;
+
+	const JPH::RMat44 transform_com = to_jolt_r(p_transform_com);
+	const JPH::Vec3 motion = to_jolt(p_motion);
+
+	const JPH::RShapeCast shape_cast(&p_jolt_shape, to_jolt(p_scale), transform_com, motion);
+
+	JPH::ShapeCastSettings settings;
+
+	if (p_use_edge_removal) {
+		// There is no shape-cast equivalent of `InternalEdgeRemovingCollector`, so the closest we
+		// can get is to only collide with active edges and let Jolt know which direction we're
+		// moving in, which takes care of most of the internal edges we would otherwise hit.
+		settings.mActiveEdgeMode = JPH::EActiveEdgeMode::CollideOnlyWithActive;
+		settings.mActiveEdgeMovementDirection = motion;
+	} else {
+		settings.mActiveEdgeMode = JPH::EActiveEdgeMode::CollideWithAll;
+	}
+
+	settings.mBackFaceModeTriangles = p_settings.mBackFaceMode;
+	settings.mBackFaceModeConvex = p_settings.mBackFaceMode;
+	settings.mCollisionTolerance = p_settings.mCollisionTolerance;
+	settings.mPenetrationTolerance = p_settings.mPenetrationTolerance;
+
+	JoltQueryCollectorAll<JPH::CastShapeCollector, 32> collector;
+
+	space->get_narrow_phase_query().CastShape(
+		shape_cast,
+		settings,
+		transform_com.GetTranslation(),
+		collector,
+		p_broad_phase_layer_filter,
+		p_object_layer_filter,
+		p_body_filter,
+		p_shape_filter
+	);
+
+	if (!collector.had_hit()) {
+		return false;
+	}
+
+	// Shape-casts only report the time of impact, so we approximate the margin by backing off the
+	// distance it takes to cover the margin along the contact normal, limited to 10x the margin.
+	auto fraction_of = [&](const JPH::ShapeCastResult& p_hit) {
+		if (margin <= 0.0f) {
+			return p_hit.mFraction;
+		}
+
+		const JPH::Vec3 axis = p_hit.mPenetrationAxis.NormalizedOr(JPH::Vec3::sZero());
+		const float approach = MAX(axis.Dot(motion) / motion_length, 0.1f);
+
+		return MAX(p_hit.mFraction - margin / (motion_length * approach), 0.0f);
+	};
+
+	InlineVector<JPH::BodyID, 8> overlapping_bodies;
+
+	if (p_ignore_overlaps) {
+		// We only consider a body to be overlapping if we're already touching it at the start of the
+		// motion, since backing off the margin would otherwise have us ignore (and tunnel through)
+		// any body that's hit just ahead of us.
+		for (int32_t i = 0; i < collector.get_hit_count(); ++i) {
+			const JPH::ShapeCastResult& hit = collector.get_hit(i);
+
+			if (hit.mFraction == 0.0f && overlapping_bodies.find(hit.mBodyID2) == -1) {
+				overlapping_bodies.push_back(hit.mBodyID2);
+			}
+		}
+	}
+
+	float closest_fraction = 1.0f;
+	bool collided = false;
+
+	for (int32_t i = 0; i < collector.get_hit_count(); ++i) {
+		const JPH::ShapeCastResult& hit = collector.get_hit(i);
+
+		if (overlapping_bodies.find(hit.mBodyID2) != -1) {
+			continue;
+		}
+
+		closest_fraction = MIN(closest_fraction, fraction_of(hit));
+		collided = true;
+	}
+
+	if (!collided) {
+		return false;
+	}
+
+	// We back off by a millimeter to get the safe fraction, matching the precision of the binary
+	// search that's used when not using swept shape-casting.
+	p_closest_unsafe = closest_fraction;
+	p_closest_safe = MAX(closest_fraction - 0.001f / motion_length, 0.0f);
+
+	return true;
+}
+
 bool JoltPhysicsDirectSpaceState3DExtension::_body_motion_recover(
 	const JoltBodyImpl3D& p_body,
 	const Transform3D& p_transform,
@@ -868,8 +2216,35 @@ bool JoltPhysicsDirectSpaceState3DExtension::_body_motion_recover(
 
 	const JoltMotionFilter3D motion_filter(p_body);
 
+	JoltBodyImpl3D::RecoveryCache cache = p_body.get_recovery_cache();
+
+	// If we're recovering from the exact same place as last time, which is common for things like
+	// a character standing still, we only need to make sure that nothing in the vicinity has moved
+	// or otherwise changed since then, which is much cheaper than redoing the recovery itself.
+	if (cache.jolt_shape == jolt_shape && cache.shape_revision == p_body.get_shape_revision() &&
+		cache.transform == p_transform && cache.margin == p_margin)
+	{
+		JoltBodyImpl3D::RecoveryNeighbors neighbors;
+
+		collect_recovery_neighbors(
+			*space,
+			*jolt_shape,
+			transform_com,
+			p_margin + cache.travel,
+			motion_filter,
+			neighbors
+		);
+
+		if (recovery_neighbors_match(neighbors, cache.neighbors)) {
+			p_recovery += cache.recovery;
+			return cache.recovered;
+		}
+	}
+
 	JoltShapeQueryCollectorAnyMulti<32> collector;
 
+	Vector3 total_recovery;
+	real_t travel = 0.0f;
 	bool recovered = false;
 
 	for (int32_t i = 0; i < recovery_iterations; ++i) {
@@ -949,10 +2324,34 @@ bool JoltPhysicsDirectSpaceState3DExtension::_body_motion_recover(
 			break;
 		}
 
-		p_recovery += recovery;
+		total_recovery += recovery;
+		travel += recovery.length();
 		transform_com.origin += recovery;
 	}
 
+	p_recovery += total_recovery;
+
+	cache.jolt_shape = jolt_shape;
+	cache.shape_revision = p_body.get_shape_revision();
+	cache.transform = p_transform;
+	cache.recovery = total_recovery;
+	cache.margin = p_margin;
+	cache.travel = (float)travel;
+	cache.recovered = recovered;
+
+	// Any neighbor that could have affected the recovery must have been within reach of the shape
+	// at some point along the way, so we grow the area we look in by the distance it traveled.
+	collect_recovery_neighbors(
+		*space,
+		*jolt_shape,
+		p_transform.translated_local(com_scaled),
+		p_margin + cache.travel,
+		motion_filter,
+		cache.neighbors
+	);
+
+	p_body.set_recovery_cache(std::move(cache));
+
 	return recovered;
 }
 
@@ -1159,7 +2558,7 @@ bool JoltPhysicsDirectSpaceState3DExtension::_body_motion_collide(
 int JoltPhysicsDirectSpaceState3DExtension::_try_get_face_index(
 	const JPH::Body& p_body,
 	const JPH::SubShapeID& p_sub_shape_id
-) {
+) const {
 	if (!JoltProjectSettings::enable_ray_cast_face_index()) {
 		return -1;
 	}
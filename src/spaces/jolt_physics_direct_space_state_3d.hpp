@@ -1,6 +1,7 @@
 #pragma once
 
 class JoltBodyImpl3D;
+class JoltQueryFilter3D;
 class JoltShapeImpl3D;
 class JoltSpace3D;
 
@@ -8,7 +9,36 @@ class JoltPhysicsDirectSpaceState3DExtension final : public PhysicsDirectSpaceSt
 	GDCLASS_QUIET(JoltPhysicsDirectSpaceState3DExtension, PhysicsDirectSpaceState3DExtension)
 
 private:
-	static void _bind_methods() { }
+	using Mutex = std::mutex;
+
+	using MutexLock = std::unique_lock<Mutex>;
+
+	using ShapeResults = LocalVector<PhysicsServer3DExtensionShapeResult>;
+
+	struct QueryCacheKey {
+		static uint32_t hash(const QueryCacheKey& p_key);
+
+		friend bool operator==(const QueryCacheKey& p_lhs, const QueryCacheKey& p_rhs) {
+			return p_lhs.jolt_shape == p_rhs.jolt_shape && p_lhs.transform == p_rhs.transform &&
+				p_lhs.margin == p_rhs.margin && p_lhs.collision_mask == p_rhs.collision_mask &&
+				p_lhs.collide_with_bodies == p_rhs.collide_with_bodies &&
+				p_lhs.collide_with_areas == p_rhs.collide_with_areas;
+		}
+
+		JPH::ShapeRefC jolt_shape;
+
+		Transform3D transform;
+
+		real_t margin = 0.0f;
+
+		uint32_t collision_mask = 0;
+
+		bool collide_with_bodies = false;
+
+		bool collide_with_areas = false;
+	};
+
+	static void _bind_methods();
 
 public:
 	JoltPhysicsDirectSpaceState3DExtension() = default;
@@ -90,6 +120,56 @@ public:
 		const Vector3& p_point
 	) const override;
 
+	Dictionary intersect_rays(
+		const PackedVector3Array& p_origins,
+		const PackedVector3Array& p_motions,
+		uint32_t p_collision_mask,
+		bool p_collide_with_bodies,
+		bool p_collide_with_areas,
+		bool p_hit_from_inside,
+		bool p_hit_back_faces
+	);
+
+	Dictionary intersect_ray_all(
+		const Vector3& p_from,
+		const Vector3& p_to,
+		uint32_t p_collision_mask,
+		bool p_collide_with_bodies,
+		bool p_collide_with_areas,
+		int32_t p_max_hits,
+		bool p_stop_at_body
+	);
+
+	Dictionary intersect_shapes(
+		const RID& p_shape_rid,
+		const TypedArray<Transform3D>& p_transforms,
+		real_t p_margin,
+		uint32_t p_collision_mask,
+		bool p_collide_with_bodies,
+		bool p_collide_with_areas,
+		int32_t p_max_results
+	);
+
+	Dictionary cast_motions(
+		const RID& p_shape_rid,
+		const TypedArray<Transform3D>& p_transforms,
+		const PackedVector3Array& p_motions,
+		real_t p_margin,
+		uint32_t p_collision_mask,
+		bool p_collide_with_bodies,
+		bool p_collide_with_areas
+	);
+
+	Dictionary collide_shapes(
+		const RID& p_shape_rid,
+		const TypedArray<Transform3D>& p_transforms,
+		real_t p_margin,
+		uint32_t p_collision_mask,
+		bool p_collide_with_bodies,
+		bool p_collide_with_areas,
+		int32_t p_max_results
+	);
+
 	bool test_body_motion(
 		const JoltBodyImpl3D& p_body,
 		const Transform3D& p_transform,
@@ -101,9 +181,144 @@ public:
 		PhysicsServer3DExtensionMotionResult* p_result
 	) const;
 
+	Dictionary test_body_motions(
+		const JoltBodyImpl3D* const* p_bodies,
+		int32_t p_body_count,
+		const TypedArray<Transform3D>& p_transforms,
+		const PackedVector3Array& p_motions,
+		float p_margin,
+		int32_t p_max_collisions,
+		bool p_collide_separation_ray,
+		bool p_recovery_as_collision
+	) const;
+
+	int64_t intersect_ray_async(
+		const Vector3& p_from,
+		const Vector3& p_to,
+		uint32_t p_collision_mask,
+		bool p_collide_with_bodies,
+		bool p_collide_with_areas,
+		bool p_hit_from_inside,
+		bool p_hit_back_faces
+	);
+
+	int64_t cast_motion_async(
+		const RID& p_shape_rid,
+		const Transform3D& p_transform,
+		const Vector3& p_motion,
+		real_t p_margin,
+		uint32_t p_collision_mask,
+		bool p_collide_with_bodies,
+		bool p_collide_with_areas
+	);
+
+	bool is_async_result_ready(int64_t p_ticket) const;
+
+	Dictionary take_async_result(int64_t p_ticket);
+
+	Dictionary get_query_cache_stats() const;
+
+	void reset_query_cache_stats();
+
+	// Unlike the other query methods, these are not guarded against being called during the physics
+	// step, since they're meant to be used for evaluating persistent queries as part of the step.
+
+	bool cast_ray(
+		const Vector3& p_from,
+		const Vector3& p_to,
+		const JoltQueryFilter3D& p_query_filter,
+		bool p_hit_from_inside,
+		bool p_hit_back_faces,
+		PhysicsServer3DExtensionRayResult& p_result
+	) const;
+
+	bool cast_shape(
+		const JPH::Shape& p_jolt_shape,
+		const Transform3D& p_transform,
+		const Vector3& p_motion,
+		float p_margin,
+		const JoltQueryFilter3D& p_query_filter,
+		real_t& p_closest_safe,
+		real_t& p_closest_unsafe,
+		PhysicsServer3DExtensionShapeRestInfo& p_info
+	) const;
+
 	JoltSpace3D& get_space() const { return *space; }
 
 private:
+	static JPH::RayCastSettings _make_ray_cast_settings(
+		bool p_hit_from_inside,
+		bool p_hit_back_faces
+	);
+
+	bool _cast_ray(
+		const JPH::RRayCast& p_ray,
+		const JPH::RayCastSettings& p_settings,
+		const JoltQueryFilter3D& p_query_filter,
+		bool p_hit_from_inside,
+		PhysicsServer3DExtensionRayResult& p_result
+	) const;
+
+	bool _resolve_ray_hit(
+		const JPH::RRayCast& p_ray,
+		const JPH::RayCastResult& p_hit,
+		bool p_hit_from_inside,
+		PhysicsServer3DExtensionRayResult& p_result
+	) const;
+
+	int32_t _intersect_shape_impl(
+		const JPH::Shape& p_jolt_shape,
+		const Transform3D& p_transform_com,
+		const Vector3& p_scale,
+		float p_margin,
+		const JoltQueryFilter3D& p_query_filter,
+		PhysicsServer3DExtensionShapeResult* p_results,
+		int32_t p_max_results
+	) const;
+
+	void _collect_shape_hits(
+		const JPH::Shape& p_jolt_shape,
+		const Transform3D& p_transform_com,
+		const Vector3& p_scale,
+		float p_margin,
+		const JoltQueryFilter3D& p_query_filter,
+		JPH::CollideShapeCollector& p_collector
+	) const;
+
+	int32_t _intersect_cached(
+		const QueryCacheKey& p_key,
+		PhysicsServer3DExtensionShapeResult* p_results,
+		int32_t p_max_results
+	);
+
+	void _intersect_uncached(const QueryCacheKey& p_key, ShapeResults& p_results) const;
+
+	int32_t _copy_cached_results(
+		const ShapeResults& p_cached_results,
+		PhysicsServer3DExtensionShapeResult* p_results,
+		int32_t p_max_results
+	) const;
+
+	bool _collide_shape_impl(
+		const JPH::Shape& p_jolt_shape,
+		const Transform3D& p_transform_com,
+		const Vector3& p_scale,
+		float p_margin,
+		const JoltQueryFilter3D& p_query_filter,
+		Vector3* p_points,
+		int32_t p_max_results,
+		int32_t& p_result_count
+	) const;
+
+	bool _rest_info_impl(
+		const JPH::Shape& p_jolt_shape,
+		const Transform3D& p_transform_com,
+		const Vector3& p_scale,
+		float p_margin,
+		const JoltQueryFilter3D& p_query_filter,
+		PhysicsServer3DExtensionShapeRestInfo& p_info
+	) const;
+
 	bool _cast_motion_impl(
 		const JPH::Shape& p_jolt_shape,
 		const Transform3D& p_transform_com,
@@ -120,6 +335,33 @@ private:
 		real_t& p_closest_unsafe
 	) const;
 
+	bool _cast_motion_swept(
+		const JPH::Shape& p_jolt_shape,
+		const Transform3D& p_transform_com,
+		const Vector3& p_scale,
+		const Vector3& p_motion,
+		bool p_use_edge_removal,
+		bool p_ignore_overlaps,
+		const JPH::CollideShapeSettings& p_settings,
+		const JPH::BroadPhaseLayerFilter& p_broad_phase_layer_filter,
+		const JPH::ObjectLayerFilter& p_object_layer_filter,
+		const JPH::BodyFilter& p_body_filter,
+		const JPH::ShapeFilter& p_shape_filter,
+		real_t& p_closest_safe,
+		real_t& p_closest_unsafe
+	) const;
+
+	bool _test_body_motion_impl(
+		const JoltBodyImpl3D& p_body,
+		const Transform3D& p_transform,
+		const Vector3& p_motion,
+		float p_margin,
+		int32_t p_max_collisions,
+		bool p_collide_separation_ray,
+		bool p_recovery_as_collision,
+		PhysicsServer3DExtensionMotionResult* p_result
+	) const;
+
 	bool _body_motion_recover(
 		const JoltBodyImpl3D& p_body,
 		const Transform3D& p_transform,
@@ -146,7 +388,7 @@ private:
 		PhysicsServer3DExtensionMotionResult* p_result
 	) const;
 
-	int _try_get_face_index(const JPH::Body& p_body, const JPH::SubShapeID& p_sub_shape_id);
+	int _try_get_face_index(const JPH::Body& p_body, const JPH::SubShapeID& p_sub_shape_id) const;
 
 	void _generate_manifold(
 		const JPH::CollideShapeResult& p_hit,
@@ -184,5 +426,15 @@ private:
 		const JPH::ShapeFilter& p_shape_filter = {}
 	) const;
 
+	HashMap<QueryCacheKey, ShapeResults, QueryCacheKey> query_cache;
+
+	mutable Mutex query_cache_mutex;
+
 	JoltSpace3D* space = nullptr;
+
+	uint64_t query_cache_version = 0;
+
+	int64_t query_cache_hits = 0;
+
+	int64_t query_cache_misses = 0;
 };
@@ -0,0 +1,314 @@
+#include "jolt_projectile_pool_impl_3d.hpp"
+
+#include "objects/jolt_area_impl_3d.hpp"
+#include "objects/jolt_body_impl_3d.hpp"
+#include "spaces/jolt_physics_direct_space_state_3d.hpp"
+#include "spaces/jolt_query_collectors.hpp"
+#include "spaces/jolt_query_filter_3d.hpp"
+#include "spaces/jolt_space_3d.hpp"
+
+namespace {
+
+template<typename TValue, typename TGetter>
+bool integrate(TValue& p_value, PhysicsServer3D::AreaSpaceOverrideMode p_mode, TGetter&& p_getter) {
+	switch (p_mode) {
+		case PhysicsServer3D::AREA_SPACE_OVERRIDE_DISABLED: {
+			return false;
+		}
+		case PhysicsServer3D::AREA_SPACE_OVERRIDE_COMBINE: {
+			p_value += std::forward<TGetter>(p_getter)();
+			return false;
+		}
+		case PhysicsServer3D::AREA_SPACE_OVERRIDE_COMBINE_REPLACE: {
+			p_value += std::forward<TGetter>(p_getter)();
+			return true;
+		}
+		case PhysicsServer3D::AREA_SPACE_OVERRIDE_REPLACE: {
+			p_value = std::forward<TGetter>(p_getter)();
+			return true;
+		}
+		case PhysicsServer3D::AREA_SPACE_OVERRIDE_REPLACE_COMBINE: {
+			p_value = std::forward<TGetter>(p_getter)();
+			return false;
+		}
+		default: {
+			ERR_FAIL_D_REPORT(vformat("Unhandled override mode: '%d'.", p_mode));
+		}
+	}
+}
+
+} // namespace
+
+void JoltProjectilePoolImpl3D::set_space(JoltSpace3D* p_space) {
+	if (space == p_space) {
+		return;
+	}
+
+	if (space != nullptr) {
+		space->remove_projectile_pool(this);
+	}
+
+	space = p_space;
+
+	if (space != nullptr) {
+		space->add_projectile_pool(this);
+	}
+
+	impacts.clear();
+}
+
+double JoltProjectilePoolImpl3D::get_jolt_param(JoltParameter p_param) const {
+	switch (p_param) {
+		case JoltPhysicsServer3DExtension::PROJECTILE_POOL_GRAVITY_SCALE: {
+			return gravity_scale;
+		}
+		case JoltPhysicsServer3DExtension::PROJECTILE_POOL_LINEAR_DRAG: {
+			return linear_drag;
+		}
+		case JoltPhysicsServer3DExtension::PROJECTILE_POOL_MASS: {
+			return mass;
+		}
+		case JoltPhysicsServer3DExtension::PROJECTILE_POOL_LIFETIME: {
+			return lifetime;
+		}
+		default: {
+			ERR_FAIL_D_REPORT(vformat("Unhandled parameter: '%d'.", p_param));
+		}
+	}
+}
+
+void JoltProjectilePoolImpl3D::set_jolt_param(JoltParameter p_param, double p_value) {
+	switch (p_param) {
+		case JoltPhysicsServer3DExtension::PROJECTILE_POOL_GRAVITY_SCALE: {
+			gravity_scale = (float)p_value;
+		} break;
+		case JoltPhysicsServer3DExtension::PROJECTILE_POOL_LINEAR_DRAG: {
+			linear_drag = MAX((float)p_value, 0.0f);
+		} break;
+		case JoltPhysicsServer3DExtension::PROJECTILE_POOL_MASS: {
+			mass = MAX((float)p_value, 0.0f);
+		} break;
+		case JoltPhysicsServer3DExtension::PROJECTILE_POOL_LIFETIME: {
+			lifetime = (float)p_value;
+		} break;
+		default: {
+			ERR_FAIL_REPORT(vformat("Unhandled parameter: '%d'.", p_param));
+		} break;
+	}
+}
+
+int64_t JoltProjectilePoolImpl3D::spawn(const Vector3& p_position, const Vector3& p_velocity) {
+	const int64_t id = next_id++;
+
+	projectiles.push_back({p_position, p_velocity, lifetime, id});
+
+	return id;
+}
+
+void JoltProjectilePoolImpl3D::clear() {
+	projectiles.clear();
+	impacts.clear();
+}
+
+PackedVector3Array JoltProjectilePoolImpl3D::get_positions() const {
+	PackedVector3Array positions;
+	positions.resize(projectiles.size());
+
+	Vector3* positions_ptr = positions.ptrw();
+
+	for (const Projectile& projectile : projectiles) {
+		*positions_ptr++ = projectile.position;
+	}
+
+	return positions;
+}
+
+Dictionary JoltProjectilePoolImpl3D::get_impacts() const {
+	const int32_t impact_count = impacts.size();
+
+	PackedInt64Array projectile_ids;
+	PackedVector3Array positions;
+	PackedVector3Array normals;
+	PackedVector3Array velocities;
+	PackedInt64Array collider_ids;
+	PackedInt32Array shapes;
+	Array rids;
+
+	projectile_ids.resize(impact_count);
+	positions.resize(impact_count);
+	normals.resize(impact_count);
+	velocities.resize(impact_count);
+	collider_ids.resize(impact_count);
+	shapes.resize(impact_count);
+	rids.resize(impact_count);
+
+	for (int32_t i = 0; i < impact_count; ++i) {
+		const Impact& impact = impacts[i];
+
+		projectile_ids[i] = impact.projectile_id;
+		positions[i] = impact.hit.position;
+		normals[i] = impact.hit.normal;
+		velocities[i] = impact.velocity;
+		collider_ids[i] = (int64_t)impact.hit.collider_id;
+		shapes[i] = impact.hit.shape;
+		rids[i] = impact.hit.rid;
+	}
+
+	Dictionary results;
+	results["projectile_id"] = projectile_ids;
+	results["position"] = positions;
+	results["normal"] = normals;
+	results["velocity"] = velocities;
+	results["collider_id"] = collider_ids;
+	results["rid"] = rids;
+	results["shape"] = shapes;
+
+	return results;
+}
+
+void JoltProjectilePoolImpl3D::step(float p_step) {
+	impacts.clear();
+
+	if (projectiles.is_empty()) {
+		return;
+	}
+
+	const JoltPhysicsDirectSpaceState3DExtension& space_state = *space->get_direct_state();
+	const JoltQueryFilter3D query_filter(space_state, collision_mask, true, false);
+
+	// Projectiles don't have a collision layer of their own, so any area that contains them gets
+	// to affect their gravity, regardless of its collision mask.
+	const JoltQueryFilter3D area_filter(space_state, UINT32_MAX, false, true);
+
+	const int32_t projectile_count = projectiles.size();
+	const float drag_factor = MAX(1.0f - linear_drag * p_step, 0.0f);
+
+	LocalVector<Impact> pending_impacts;
+	pending_impacts.resize(projectile_count);
+
+	// Each projectile only ever touches its own state and its own slot in the pending impacts, so
+	// we can safely move all of them in parallel, as long as we hold off on applying any impulses.
+	space->run_jobs("Projectiles", projectile_count, 64, [&](int32_t p_begin, int32_t p_end) {
+		for (int32_t i = p_begin; i < p_end; ++i) {
+			Projectile& projectile = projectiles[i];
+
+			const Vector3 gravity = _compute_gravity(projectile.position, area_filter);
+			projectile.velocity += gravity * gravity_scale * p_step;
+
+			projectile.velocity *= drag_factor;
+			projectile.time_left -= p_step;
+
+			const Vector3 motion = projectile.velocity * p_step;
+
+			if (motion == Vector3()) {
+				continue;
+			}
+
+			Impact& impact = pending_impacts[i];
+			impact.hit.shape = -1;
+			impact.hit.face_index = -1;
+
+			impact.valid = space_state.cast_ray(
+				projectile.position,
+				projectile.position + motion,
+				query_filter,
+				false,
+				true,
+				impact.hit
+			);
+
+			if (impact.valid) {
+				impact.velocity = projectile.velocity;
+				impact.projectile_id = projectile.id;
+			} else {
+				projectile.position += motion;
+			}
+		}
+	});
+
+	int32_t alive_count = 0;
+
+	for (int32_t i = 0; i < projectile_count; ++i) {
+		const Impact& impact = pending_impacts[i];
+
+		if (impact.valid) {
+			_apply_impulse(impact);
+			impacts.push_back(impact);
+		} else if (projectiles[i].time_left > 0.0f) {
+			projectiles[alive_count++] = projectiles[i];
+		}
+	}
+
+	projectiles.resize(alive_count);
+}
+
+Vector3 JoltProjectilePoolImpl3D::_compute_gravity(
+	const Vector3& p_position,
+	const JoltQueryFilter3D& p_area_filter
+) const {
+	JoltQueryCollectorAnyMultiScratch<JPH::CollidePointCollector> collector;
+
+	space->get_narrow_phase_query().CollidePoint(
+		to_jolt_r(p_position),
+		collector,
+		p_area_filter,
+		p_area_filter,
+		p_area_filter
+	);
+
+	InlineVector<const JoltAreaImpl3D*, 8> areas;
+
+	for (int32_t i = 0; i < collector.get_hit_count(); ++i) {
+		const JoltReadableBody3D jolt_body = space->read_body(collector.get_hit(i).mBodyID);
+		const JoltAreaImpl3D* area = jolt_body.as_area();
+
+		if (area == nullptr || areas.find(area) != -1) {
+			continue;
+		}
+
+		areas.ordered_insert(area, [](const JoltAreaImpl3D* p_lhs, const JoltAreaImpl3D* p_rhs) {
+			return p_lhs->get_priority() > p_rhs->get_priority();
+		});
+	}
+
+	// This mirrors how `JoltBodyImpl3D` integrates the gravity of the areas it's in.
+
+	Vector3 gravity;
+
+	bool gravity_done = false;
+
+	for (const JoltAreaImpl3D* area : areas) {
+		gravity_done = integrate(gravity, area->get_gravity_mode(), [&]() {
+			return area->compute_gravity(p_position);
+		});
+
+		if (gravity_done) {
+			break;
+		}
+	}
+
+	const JoltAreaImpl3D* default_area = space->get_default_area();
+
+	if (!gravity_done && default_area != nullptr) {
+		gravity += default_area->compute_gravity(p_position);
+	}
+
+	return gravity;
+}
+
+void JoltProjectilePoolImpl3D::_apply_impulse(const Impact& p_impact) const {
+	if (mass == 0.0f) {
+		return;
+	}
+
+	JoltPhysicsServer3DExtension* physics_server = JoltPhysicsServer3DExtension::get_singleton();
+	JoltBodyImpl3D* body = physics_server->get_body(p_impact.hit.rid);
+
+	if (body == nullptr || !body->is_rigid()) {
+		return;
+	}
+
+	const Vector3 position_relative = p_impact.hit.position - body->get_center_of_mass();
+
+	body->apply_impulse(p_impact.velocity * mass, position_relative);
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "servers/jolt_physics_server_3d.hpp"
+
+class JoltQueryFilter3D;
+class JoltSpace3D;
+
+class JoltProjectilePoolImpl3D {
+	struct Projectile {
+		Vector3 position;
+
+		Vector3 velocity;
+
+		float time_left = 0.0f;
+
+		int64_t id = 0;
+	};
+
+	struct Impact {
+		PhysicsServer3DExtensionRayResult hit = {};
+
+		Vector3 velocity;
+
+		int64_t projectile_id = 0;
+
+		bool valid = false;
+	};
+
+public:
+	using JoltParameter = JoltPhysicsServer3DExtension::ProjectilePoolParamJolt;
+
+	RID get_rid() const { return rid; }
+
+	void set_rid(const RID& p_rid) { rid = p_rid; }
+
+	JoltSpace3D* get_space() const { return space; }
+
+	void set_space(JoltSpace3D* p_space);
+
+	uint32_t get_collision_mask() const { return collision_mask; }
+
+	void set_collision_mask(uint32_t p_mask) { collision_mask = p_mask; }
+
+	double get_jolt_param(JoltParameter p_param) const;
+
+	void set_jolt_param(JoltParameter p_param, double p_value);
+
+	int64_t spawn(const Vector3& p_position, const Vector3& p_velocity);
+
+	void clear();
+
+	int32_t get_count() const { return projectiles.size(); }
+
+	PackedVector3Array get_positions() const;
+
+	Dictionary get_impacts() const;
+
+	void step(float p_step);
+
+private:
+	Vector3 _compute_gravity(
+		const Vector3& p_position,
+		const JoltQueryFilter3D& p_area_filter
+	) const;
+
+	void _apply_impulse(const Impact& p_impact) const;
+
+	LocalVector<Projectile> projectiles;
+
+	LocalVector<Impact> impacts;
+
+	RID rid;
+
+	JoltSpace3D* space = nullptr;
+
+	int64_t next_id = 1;
+
+	uint32_t collision_mask = 1;
+
+	float gravity_scale = 1.0f;
+
+	float linear_drag = 0.0f;
+
+	float mass = 0.01f;
+
+	float lifetime = 5.0f;
+};
@@ -2,6 +2,76 @@
 
 #include "spaces/jolt_space_3d.hpp"
 
+// Borrows a vector from a pool owned by the calling thread, which keeps its capacity once handed
+// back, meaning that any query that uses it will stop allocating once it's been warmed up.
+template<typename TElement>
+class JoltQueryScratch {
+	using Vector = LocalVector<TElement>;
+
+	struct Pool {
+		~Pool() {
+			for (Vector*& vector : vectors) {
+				delete_safely(vector);
+			}
+		}
+
+		LocalVector<Vector*> vectors;
+	};
+
+public:
+	JoltQueryScratch()
+		: vector(_borrow()) { }
+
+	JoltQueryScratch(const JoltQueryScratch& p_other) = delete;
+
+	JoltQueryScratch(JoltQueryScratch&& p_other) = delete;
+
+	~JoltQueryScratch() { _give_back(vector); }
+
+	bool is_empty() const { return vector->is_empty(); }
+
+	int32_t size() const { return vector->size(); }
+
+	void clear() { vector->clear(); }
+
+	void push_back(const TElement& p_value) { vector->push_back(p_value); }
+
+	const TElement* ptr() const { return vector->ptr(); }
+
+	const TElement& operator[](int32_t p_index) const { return (*vector)[p_index]; }
+
+	JoltQueryScratch& operator=(const JoltQueryScratch& p_other) = delete;
+
+	JoltQueryScratch& operator=(JoltQueryScratch&& p_other) = delete;
+
+private:
+	static Pool& _get_pool() {
+		thread_local Pool pool;
+		return pool;
+	}
+
+	static Vector* _borrow() {
+		LocalVector<Vector*>& vectors = _get_pool().vectors;
+
+		if (vectors.is_empty()) {
+			return new Vector();
+		}
+
+		const int32_t last_index = vectors.size() - 1;
+		Vector* vector = vectors[last_index];
+		vectors.remove_at(last_index);
+
+		return vector;
+	}
+
+	static void _give_back(Vector* p_vector) {
+		p_vector->clear();
+		_get_pool().vectors.push_back(p_vector);
+	}
+
+	Vector* vector = nullptr;
+};
+
 template<typename TBase, int32_t TInlineCapacity>
 class JoltQueryCollectorAll final : public TBase {
 public:
@@ -95,6 +165,44 @@ private:
 	int32_t max_hits = 0;
 };
 
+template<typename TBase>
+class JoltQueryCollectorAnyMultiScratch final : public TBase {
+public:
+	using Hit = typename TBase::ResultType;
+
+	explicit JoltQueryCollectorAnyMultiScratch(int32_t p_max_hits = INT32_MAX)
+		: max_hits(p_max_hits) { }
+
+	bool had_hit() const { return hits.size() > 0; }
+
+	int32_t get_hit_count() const { return hits.size(); }
+
+	const Hit& get_hit(int32_t p_index) const { return hits[p_index]; }
+
+	void reset() { Reset(); }
+
+	void Reset() override {
+		TBase::Reset();
+
+		hits.clear();
+	}
+
+	void AddHit(const Hit& p_hit) override {
+		if (hits.size() < max_hits) {
+			hits.push_back(p_hit);
+		}
+
+		if (hits.size() == max_hits) {
+			TBase::ForceEarlyOut();
+		}
+	}
+
+private:
+	JoltQueryScratch<Hit> hits;
+
+	int32_t max_hits = 0;
+};
+
 template<typename TBase>
 class JoltQueryCollectorClosest final : public TBase {
 public:
@@ -167,6 +275,78 @@ private:
 	int32_t max_hits = 0;
 };
 
+// Gathers every hit along a ray, sorted by distance, optionally dropping anything beyond the first
+// hit that isn't an area, since anything beyond that would be hidden behind a solid body anyway.
+class JoltRayQueryCollectorAllSorted final : public JPH::CastRayCollector {
+public:
+	using Hit = JPH::RayCastResult;
+
+	JoltRayQueryCollectorAllSorted(const JoltSpace3D& p_space, int32_t p_max_hits)
+		: space(p_space)
+		, max_hits(p_max_hits) { }
+
+	bool had_hit() const { return !hits.is_empty(); }
+
+	int32_t get_hit_count() const { return hits.size(); }
+
+	const Hit& get_hit(int32_t p_index) const { return hits[p_index]; }
+
+	void reset() { Reset(); }
+
+	// This is meant to be called once the cast is done, rather than being done as part of `AddHit`,
+	// so that we only need to look up the bodies of the hits that we actually end up keeping.
+	void stop_at_body() {
+		const int32_t body_index = hits.find_if([&](const Hit& p_hit) {
+			return !space.read_body(p_hit.mBodyID)->IsSensor();
+		});
+
+		if (body_index == -1) {
+			return;
+		}
+
+		const float body_fraction = hits[body_index].mFraction;
+
+		const int32_t end_index = hits.find_if([&](const Hit& p_hit) {
+			return p_hit.mFraction > body_fraction;
+		});
+
+		if (end_index != -1) {
+			hits.resize(end_index);
+		}
+	}
+
+	void Reset() override {
+		JPH::CastRayCollector::Reset();
+
+		hits.clear();
+	}
+
+	void AddHit(const Hit& p_hit) override {
+		hits.ordered_insert(p_hit, [](const Hit& p_lhs, const Hit& p_rhs) {
+			return p_lhs.mFraction < p_rhs.mFraction;
+		});
+
+		if (hits.size() > max_hits) {
+			hits.resize(max_hits);
+		}
+
+		if (hits.size() == max_hits) {
+			const float early_out = hits[max_hits - 1].mFraction;
+
+			if (early_out < GetEarlyOutFraction()) {
+				UpdateEarlyOutFraction(early_out);
+			}
+		}
+	}
+
+private:
+	InlineVector<Hit, 32> hits;
+
+	const JoltSpace3D& space;
+
+	int32_t max_hits = 0;
+};
+
 using JoltShapeQueryCollectorAny = JoltQueryCollectorAny<JPH::CollideShapeCollector>;
 
 template<int32_t TInlineCapacity>
@@ -174,6 +354,9 @@ using JoltShapeQueryCollectorAnyMulti = JoltQueryCollectorAnyMulti<
 	JPH::CollideShapeCollector,
 	TInlineCapacity>;
 
+using JoltShapeQueryCollectorAnyMultiScratch = JoltQueryCollectorAnyMultiScratch<
+	JPH::CollideShapeCollector>;
+
 using JoltShapeQueryCollectorClosest = JoltQueryCollectorClosest<JPH::CollideShapeCollector>;
 
 template<int32_t TInlineCapacity>
@@ -17,7 +17,9 @@ JoltQueryFilter3D::JoltQueryFilter3D(
 	, collision_mask(p_collision_mask)
 	, collide_with_bodies(p_collide_with_bodies)
 	, collide_with_areas(p_collide_with_areas)
-	, picking(p_picking) { }
+	, picking(p_picking) {
+	space.get_object_layers_in_mask(collision_mask, accepted_object_layers);
+}
 
 bool JoltQueryFilter3D::ShouldCollide(JPH::BroadPhaseLayer p_broad_phase_layer) const {
 	const auto broad_phase_layer = (JPH::BroadPhaseLayer::Type)p_broad_phase_layer;
@@ -39,18 +41,7 @@ bool JoltQueryFilter3D::ShouldCollide(JPH::BroadPhaseLayer p_broad_phase_layer)
 }
 
 bool JoltQueryFilter3D::ShouldCollide(JPH::ObjectLayer p_object_layer) const {
-	JPH::BroadPhaseLayer object_broad_phase_layer = {};
-	uint32_t object_collision_layer = 0;
-	uint32_t object_collision_mask = 0;
-
-	space.map_from_object_layer(
-		p_object_layer,
-		object_broad_phase_layer,
-		object_collision_layer,
-		object_collision_mask
-	);
-
-	return (collision_mask & object_collision_layer) != 0;
+	return accepted_object_layers.has(p_object_layer);
 }
 
 bool JoltQueryFilter3D::ShouldCollide([[maybe_unused]] const JPH::BodyID& p_body_id) const {
@@ -60,6 +51,9 @@ bool JoltQueryFilter3D::ShouldCollide([[maybe_unused]] const JPH::BodyID& p_body
 bool JoltQueryFilter3D::ShouldCollideLocked(const JPH::Body& p_body) const {
 	auto* object = reinterpret_cast<JoltObjectImpl3D*>(p_body.GetUserData());
 
+	const RID object_rid = object->get_rid();
+
 	return (!picking || object->is_pickable()) &&
-		!space_state.is_body_excluded_from_query(object->get_rid());
+		(excluded_objects == nullptr || !excluded_objects->has(object_rid)) &&
+		(!use_query_exclusions || !space_state.is_body_excluded_from_query(object_rid));
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "spaces/jolt_object_layer_set.hpp"
+
 class JoltPhysicsDirectSpaceState3DExtension;
 class JoltSpace3D;
 
@@ -24,11 +26,19 @@ public:
 
 	bool ShouldCollideLocked(const JPH::Body& p_body) const override;
 
+	void set_excluded_objects(const HashSet<RID>* p_objects) { excluded_objects = p_objects; }
+
+	void set_use_query_exclusions(bool p_enabled) { use_query_exclusions = p_enabled; }
+
 private:
 	const JoltPhysicsDirectSpaceState3DExtension& space_state;
 
 	const JoltSpace3D& space;
 
+	JoltObjectLayerSet accepted_object_layers;
+
+	const HashSet<RID>* excluded_objects = nullptr;
+
 	uint32_t collision_mask = 0;
 
 	bool collide_with_bodies = false;
@@ -36,4 +46,6 @@ private:
 	bool collide_with_areas = false;
 
 	bool picking = false;
+
+	bool use_query_exclusions = true;
 };
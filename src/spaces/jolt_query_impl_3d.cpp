@@ -0,0 +1,214 @@
+#include "jolt_query_impl_3d.hpp"
+
+#include "shapes/jolt_shape_impl_3d.hpp"
+#include "spaces/jolt_physics_direct_space_state_3d.hpp"
+#include "spaces/jolt_query_filter_3d.hpp"
+#include "spaces/jolt_space_3d.hpp"
+
+JoltQueryImpl3D::~JoltQueryImpl3D() {
+	if (shape != nullptr) {
+		shape->remove_query(this);
+	}
+}
+
+void JoltQueryImpl3D::set_space(JoltSpace3D* p_space) {
+	if (space == p_space) {
+		return;
+	}
+
+	if (space != nullptr) {
+		space->remove_query(this);
+	}
+
+	space = p_space;
+
+	if (space != nullptr) {
+		space->add_query(this);
+	}
+
+	_clear_result();
+}
+
+RID JoltQueryImpl3D::get_shape() const {
+	return shape != nullptr ? shape->get_rid() : RID();
+}
+
+void JoltQueryImpl3D::set_shape(JoltShapeImpl3D* p_shape) {
+	if (shape != nullptr) {
+		shape->remove_query(this);
+	}
+
+	shape = p_shape;
+
+	if (shape != nullptr) {
+		shape->add_query(this);
+	}
+
+	_shape_changed();
+}
+
+bool JoltQueryImpl3D::get_jolt_flag(JoltFlag p_flag) const {
+	switch (p_flag) {
+		case JoltPhysicsServer3DExtension::QUERY_FLAG_ENABLED: {
+			return enabled;
+		}
+		case JoltPhysicsServer3DExtension::QUERY_FLAG_COLLIDE_WITH_BODIES: {
+			return collide_with_bodies;
+		}
+		case JoltPhysicsServer3DExtension::QUERY_FLAG_COLLIDE_WITH_AREAS: {
+			return collide_with_areas;
+		}
+		case JoltPhysicsServer3DExtension::QUERY_FLAG_HIT_FROM_INSIDE: {
+			return hit_from_inside;
+		}
+		case JoltPhysicsServer3DExtension::QUERY_FLAG_HIT_BACK_FACES: {
+			return hit_back_faces;
+		}
+		default: {
+			ERR_FAIL_D_REPORT(vformat("Unhandled flag: '%d'.", p_flag));
+		}
+	}
+}
+
+void JoltQueryImpl3D::set_jolt_flag(JoltFlag p_flag, bool p_enabled) {
+	switch (p_flag) {
+		case JoltPhysicsServer3DExtension::QUERY_FLAG_ENABLED: {
+			enabled = p_enabled;
+
+			if (!enabled) {
+				_clear_result();
+			}
+		} break;
+		case JoltPhysicsServer3DExtension::QUERY_FLAG_COLLIDE_WITH_BODIES: {
+			collide_with_bodies = p_enabled;
+		} break;
+		case JoltPhysicsServer3DExtension::QUERY_FLAG_COLLIDE_WITH_AREAS: {
+			collide_with_areas = p_enabled;
+		} break;
+		case JoltPhysicsServer3DExtension::QUERY_FLAG_HIT_FROM_INSIDE: {
+			hit_from_inside = p_enabled;
+		} break;
+		case JoltPhysicsServer3DExtension::QUERY_FLAG_HIT_BACK_FACES: {
+			hit_back_faces = p_enabled;
+		} break;
+		default: {
+			ERR_FAIL_REPORT(vformat("Unhandled flag: '%d'.", p_flag));
+		} break;
+	}
+}
+
+Dictionary JoltQueryImpl3D::get_result() const {
+	Dictionary result;
+
+	result["colliding"] = colliding;
+
+	switch (type) {
+		case JoltPhysicsServer3DExtension::QUERY_TYPE_RAY: {
+			result["position"] = ray_result.position;
+			result["normal"] = ray_result.normal;
+			result["collider_id"] = ray_result.collider_id;
+			result["rid"] = ray_result.rid;
+			result["shape"] = ray_result.shape;
+			result["face_index"] = ray_result.face_index;
+		} break;
+		case JoltPhysicsServer3DExtension::QUERY_TYPE_SHAPE_CAST: {
+			result["safe_fraction"] = closest_safe;
+			result["unsafe_fraction"] = closest_unsafe;
+			result["position"] = rest_info.point;
+			result["normal"] = rest_info.normal;
+			result["collider_id"] = rest_info.collider_id;
+			result["rid"] = rest_info.rid;
+			result["shape"] = rest_info.shape;
+			result["linear_velocity"] = rest_info.linear_velocity;
+		} break;
+		default: {
+			ERR_FAIL_D_REPORT(vformat("Unhandled query type: '%d'.", type));
+		}
+	}
+
+	return result;
+}
+
+void JoltQueryImpl3D::evaluate(const JoltPhysicsDirectSpaceState3DExtension& p_space_state) {
+	if (!enabled) {
+		return;
+	}
+
+	switch (type) {
+		case JoltPhysicsServer3DExtension::QUERY_TYPE_RAY: {
+			_evaluate_ray(p_space_state);
+		} break;
+		case JoltPhysicsServer3DExtension::QUERY_TYPE_SHAPE_CAST: {
+			_evaluate_shape_cast(p_space_state);
+		} break;
+		default: {
+			ERR_FAIL_REPORT(vformat("Unhandled query type: '%d'.", type));
+		} break;
+	}
+}
+
+void JoltQueryImpl3D::_shape_changed() {
+	// We build the shape up front, rather than every time we evaluate, since the shape won't be
+	// changing between steps anyway and this keeps the evaluation free of any shape lookups. The
+	// shape lets us know whenever it does change, at which point we build it again.
+	jolt_shape = shape != nullptr ? shape->try_build() : nullptr;
+
+	if (jolt_shape == nullptr) {
+		_clear_result();
+	}
+}
+
+void JoltQueryImpl3D::_clear_result() {
+	colliding = false;
+	ray_result = {};
+	rest_info = {};
+	closest_safe = 1.0f;
+	closest_unsafe = 1.0f;
+}
+
+void JoltQueryImpl3D::_evaluate_ray(const JoltPhysicsDirectSpaceState3DExtension& p_space_state) {
+	JoltQueryFilter3D
+		query_filter(p_space_state, collision_mask, collide_with_bodies, collide_with_areas);
+
+	query_filter.set_excluded_objects(&exceptions);
+
+	ray_result = {};
+
+	colliding = p_space_state.cast_ray(
+		transform.origin,
+		transform.xform(target_position),
+		query_filter,
+		hit_from_inside,
+		hit_back_faces,
+		ray_result
+	);
+}
+
+void JoltQueryImpl3D::_evaluate_shape_cast(
+	const JoltPhysicsDirectSpaceState3DExtension& p_space_state
+) {
+	if (jolt_shape == nullptr) {
+		_clear_result();
+		return;
+	}
+
+	JoltQueryFilter3D
+		query_filter(p_space_state, collision_mask, collide_with_bodies, collide_with_areas);
+
+	query_filter.set_excluded_objects(&exceptions);
+
+	rest_info = {};
+	closest_safe = 1.0f;
+	closest_unsafe = 1.0f;
+
+	colliding = p_space_state.cast_shape(
+		*jolt_shape,
+		transform,
+		transform.basis.xform(target_position),
+		margin,
+		query_filter,
+		closest_safe,
+		closest_unsafe,
+		rest_info
+	);
+}
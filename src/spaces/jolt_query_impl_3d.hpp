@@ -0,0 +1,116 @@
+#pragma once
+
+#include "servers/jolt_physics_server_3d.hpp"
+
+class JoltPhysicsDirectSpaceState3DExtension;
+class JoltShapeImpl3D;
+class JoltSpace3D;
+
+class JoltQueryImpl3D {
+public:
+	using QueryType = JoltPhysicsServer3DExtension::QueryTypeJolt;
+
+	using JoltFlag = JoltPhysicsServer3DExtension::QueryFlagJolt;
+
+	explicit JoltQueryImpl3D(QueryType p_type)
+		: type(p_type) { }
+
+	~JoltQueryImpl3D();
+
+	RID get_rid() const { return rid; }
+
+	void set_rid(const RID& p_rid) { rid = p_rid; }
+
+	QueryType get_type() const { return type; }
+
+	JoltSpace3D* get_space() const { return space; }
+
+	void set_space(JoltSpace3D* p_space);
+
+	RID get_shape() const;
+
+	void set_shape(JoltShapeImpl3D* p_shape);
+
+	Transform3D get_transform() const { return transform; }
+
+	void set_transform(const Transform3D& p_transform) { transform = p_transform; }
+
+	Vector3 get_target_position() const { return target_position; }
+
+	void set_target_position(const Vector3& p_position) { target_position = p_position; }
+
+	float get_margin() const { return margin; }
+
+	void set_margin(float p_margin) { margin = p_margin; }
+
+	uint32_t get_collision_mask() const { return collision_mask; }
+
+	void set_collision_mask(uint32_t p_mask) { collision_mask = p_mask; }
+
+	bool get_jolt_flag(JoltFlag p_flag) const;
+
+	void set_jolt_flag(JoltFlag p_flag, bool p_enabled);
+
+	void add_exception(const RID& p_object) { exceptions.insert(p_object); }
+
+	void remove_exception(const RID& p_object) { exceptions.erase(p_object); }
+
+	void clear_exceptions() { exceptions.clear(); }
+
+	bool is_colliding() const { return colliding; }
+
+	Dictionary get_result() const;
+
+	void evaluate(const JoltPhysicsDirectSpaceState3DExtension& p_space_state);
+
+private:
+	friend class JoltShapeImpl3D;
+
+	void _shape_changed();
+
+	void _clear_result();
+
+	void _evaluate_ray(const JoltPhysicsDirectSpaceState3DExtension& p_space_state);
+
+	void _evaluate_shape_cast(const JoltPhysicsDirectSpaceState3DExtension& p_space_state);
+
+	HashSet<RID> exceptions;
+
+	JPH::ShapeRefC jolt_shape;
+
+	PhysicsServer3DExtensionRayResult ray_result = {};
+
+	PhysicsServer3DExtensionShapeRestInfo rest_info = {};
+
+	RID rid;
+
+	Transform3D transform;
+
+	Vector3 target_position = Vector3(0.0f, -1.0f, 0.0f);
+
+	JoltShapeImpl3D* shape = nullptr;
+
+	JoltSpace3D* space = nullptr;
+
+	QueryType type = JoltPhysicsServer3DExtension::QUERY_TYPE_RAY;
+
+	uint32_t collision_mask = 1;
+
+	float margin = 0.0f;
+
+	real_t closest_safe = 1.0f;
+
+	real_t closest_unsafe = 1.0f;
+
+	bool enabled = true;
+
+	bool collide_with_bodies = true;
+
+	bool collide_with_areas = false;
+
+	bool hit_from_inside = false;
+
+	bool hit_back_faces = true;
+
+	bool colliding = false;
+};
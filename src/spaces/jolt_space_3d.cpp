@@ -3,6 +3,7 @@
 #include "joints/jolt_joint_impl_3d.hpp"
 #include "objects/jolt_area_impl_3d.hpp"
 #include "objects/jolt_body_impl_3d.hpp"
+#include "objects/jolt_character_impl_3d.hpp"
 #include "servers/jolt_physics_server_3d.hpp"
 #include "servers/jolt_project_settings.hpp"
 #include "shapes/jolt_custom_shape_type.hpp"
@@ -11,6 +12,8 @@
 #include "spaces/jolt_contact_listener_3d.hpp"
 #include "spaces/jolt_layer_mapper.hpp"
 #include "spaces/jolt_physics_direct_space_state_3d.hpp"
+#include "spaces/jolt_projectile_pool_impl_3d.hpp"
+#include "spaces/jolt_query_impl_3d.hpp"
 #include "spaces/jolt_temp_allocator.hpp"
 
 namespace {
@@ -23,6 +26,11 @@ constexpr double DEFAULT_SLEEP_THRESHOLD_LINEAR = 0.1;
 constexpr double DEFAULT_SLEEP_THRESHOLD_ANGULAR = 8.0 * Math_PI / 180;
 constexpr double DEFAULT_SOLVER_ITERATIONS = 8;
 
+// Results of asynchronous queries that haven't been taken after this many collection passes (i.e.
+// calls to `call_queries`) are assumed to have been abandoned, and are discarded so that they don't
+// pile up forever.
+constexpr int64_t ASYNC_QUERY_RESULT_LIFETIME = 60;
+
 } // namespace
 
 JoltSpace3D::JoltSpace3D(JPH::JobSystem* p_job_system)
@@ -141,6 +149,32 @@ JoltSpace3D::JoltSpace3D(JPH::JobSystem* p_job_system)
 }
 
 JoltSpace3D::~JoltSpace3D() {
+	// Unlike bodies and joints, which get removed from the space by their nodes, these only exist
+	// on the server, so nothing else makes sure they let go of the space before it's freed.
+	while (!characters.is_empty()) {
+		characters[characters.size() - 1]->set_space(nullptr);
+	}
+
+	while (!queries.is_empty()) {
+		queries[queries.size() - 1]->set_space(nullptr);
+	}
+
+	while (!projectile_pools.is_empty()) {
+		projectile_pools[projectile_pools.size() - 1]->set_space(nullptr);
+	}
+
+	for (AsyncQuery& async_query : pending_async_queries) {
+		memdelete_safely(async_query.query);
+	}
+
+	for (AsyncQuery& async_query : evaluated_async_queries) {
+		memdelete_safely(async_query.query);
+	}
+
+	for (auto& [ticket, async_query] : completed_async_queries) {
+		memdelete_safely(async_query.query);
+	}
+
 	memdelete_safely(direct_state);
 	delete_safely(physics_system);
 	delete_safely(body_activation_listener);
@@ -150,10 +184,24 @@ JoltSpace3D::~JoltSpace3D() {
 }
 
 void JoltSpace3D::step(float p_step) {
+	if (JoltProjectSettings::allow_concurrent_queries()) {
+		stepping = true;
+
+		// Any query that made it past the guard before we raised the flag gets to finish first,
+		// since we're about to start modifying the very things it's reading from.
+		while (active_queries > 0) {
+			std::this_thread::yield();
+		}
+	}
+
 	last_step = p_step;
 
 	_pre_step(p_step);
 
+	_update_characters(p_step);
+
+	_update_projectiles(p_step);
+
 	physics_system->SetBodyActivationListener(body_activation_listener);
 
 	const JPH::EPhysicsUpdateError
@@ -194,13 +242,20 @@ void JoltSpace3D::step(float p_step) {
 
 	physics_system->SetBodyActivationListener(nullptr);
 
+	_evaluate_queries();
+
 	_post_step(p_step);
 
+	invalidate_query_cache();
+
 	has_stepped = true;
 	bodies_added_since_optimizing = 0;
+	stepping = false;
 }
 
 void JoltSpace3D::call_queries() {
+	_collect_async_queries();
+
 	if (!has_stepped) {
 		// HACK(mihe): We need to skip the first invocation of this method, because there will be
 		// pending notifications that need to be flushed first, which can cause weird conflicts with
@@ -370,6 +425,13 @@ void JoltSpace3D::map_from_object_layer(
 	);
 }
 
+void JoltSpace3D::get_object_layers_in_mask(
+	uint32_t p_collision_mask,
+	JoltObjectLayerSet& p_layers
+) const {
+	layer_mapper->get_object_layers_in_mask(p_collision_mask, p_layers);
+}
+
 JoltReadableBody3D JoltSpace3D::read_body(const JPH::BodyID& p_body_id) const {
 	return {*this, p_body_id};
 }
@@ -449,6 +511,8 @@ JPH::BodyID JoltSpace3D::add_rigid_body(
 
 	bodies_added_since_optimizing += 1;
 
+	invalidate_query_cache();
+
 	return body_id;
 }
 
@@ -474,6 +538,8 @@ JPH::BodyID JoltSpace3D::add_soft_body(
 
 	bodies_added_since_optimizing += 1;
 
+	invalidate_query_cache();
+
 	return body_id;
 }
 
@@ -482,6 +548,8 @@ void JoltSpace3D::remove_body(const JPH::BodyID& p_body_id) {
 
 	body_iface.RemoveBody(p_body_id);
 	body_iface.DestroyBody(p_body_id);
+
+	invalidate_query_cache();
 }
 
 void JoltSpace3D::try_optimize() {
@@ -497,11 +565,41 @@ void JoltSpace3D::try_optimize() {
 		return;
 	}
 
+	if (JoltProjectSettings::allow_concurrent_queries()) {
+		// Other threads could be walking the broad phase at this very moment, so when queries are
+		// allowed to run concurrently we leave this to the next step instead, which rebuilds the
+		// broad phase while queries are being held off.
+		return;
+	}
+
 	physics_system->OptimizeBroadPhase();
 
 	bodies_added_since_optimizing = 0;
 }
 
+bool JoltSpace3D::try_begin_query() const {
+	if (!JoltProjectSettings::allow_concurrent_queries()) {
+		return true;
+	}
+
+	active_queries += 1;
+
+	if (unlikely(stepping)) {
+		active_queries -= 1;
+		return false;
+	}
+
+	return true;
+}
+
+void JoltSpace3D::end_query() const {
+	if (!JoltProjectSettings::allow_concurrent_queries()) {
+		return;
+	}
+
+	active_queries -= 1;
+}
+
 void JoltSpace3D::add_joint(JPH::Constraint* p_jolt_ref) {
 	physics_system->AddConstraint(p_jolt_ref);
 }
@@ -518,6 +616,70 @@ void JoltSpace3D::remove_joint(JoltJointImpl3D* p_joint) {
 	remove_joint(p_joint->get_jolt_ref());
 }
 
+void JoltSpace3D::add_character(JoltCharacterImpl3D* p_character) {
+	characters.push_back(p_character);
+}
+
+void JoltSpace3D::remove_character(JoltCharacterImpl3D* p_character) {
+	const int32_t index = characters.find(p_character);
+	ERR_FAIL_COND(index == -1);
+
+	characters.remove_at_unordered(index);
+}
+
+void JoltSpace3D::add_query(JoltQueryImpl3D* p_query) {
+	queries.push_back(p_query);
+}
+
+void JoltSpace3D::remove_query(JoltQueryImpl3D* p_query) {
+	const int32_t index = queries.find(p_query);
+	ERR_FAIL_COND(index == -1);
+
+	queries.remove_at_unordered(index);
+}
+
+void JoltSpace3D::add_projectile_pool(JoltProjectilePoolImpl3D* p_pool) {
+	projectile_pools.push_back(p_pool);
+}
+
+void JoltSpace3D::remove_projectile_pool(JoltProjectilePoolImpl3D* p_pool) {
+	const int32_t index = projectile_pools.find(p_pool);
+	ERR_FAIL_COND(index == -1);
+
+	projectile_pools.remove_at_unordered(index);
+}
+
+int64_t JoltSpace3D::submit_async_query(JoltQueryImpl3D* p_query) {
+	const MutexLock lock(async_queries_mutex);
+
+	const int64_t ticket = next_async_ticket++;
+
+	pending_async_queries.push_back({p_query, ticket});
+
+	return ticket;
+}
+
+bool JoltSpace3D::is_async_query_ready(int64_t p_ticket) const {
+	const MutexLock lock(async_queries_mutex);
+
+	return completed_async_queries.has(p_ticket);
+}
+
+JoltQueryImpl3D* JoltSpace3D::take_async_query(int64_t p_ticket) {
+	const MutexLock lock(async_queries_mutex);
+
+	auto iter = completed_async_queries.find(p_ticket);
+
+	if (iter == completed_async_queries.end()) {
+		return nullptr;
+	}
+
+	JoltQueryImpl3D* query = iter->second.query;
+	completed_async_queries.remove(iter);
+
+	return query;
+}
+
 #ifdef GDJ_CONFIG_EDITOR
 
 void JoltSpace3D::dump_debug_snapshot(const String& p_dir) {
@@ -619,9 +781,17 @@ void JoltSpace3D::_pre_step(float p_step) {
 			if (object->reports_contacts()) {
 				contact_listener->listen_for(object);
 			}
+
+			if (const JoltBodyImpl3D* body = object->as_body()) {
+				if (body->is_buoyant(*jolt_body)) {
+					buoyant_bodies.push_back(jolt_body);
+				}
+			}
 		}
 	}
 
+	_apply_buoyancy(p_step);
+
 	body_accessor.release();
 }
 
@@ -646,3 +816,139 @@ void JoltSpace3D::_post_step(float p_step) {
 
 	body_accessor.release();
 }
+
+void JoltSpace3D::_apply_buoyancy(float p_step) {
+	if (buoyant_bodies.is_empty()) {
+		return;
+	}
+
+	// Every body only ever gets written to by the one job that owns its index, and the areas are
+	// only read from, so we can safely spread these across the job system without any locking.
+	run_jobs("Buoyancy", buoyant_bodies.size(), 16, [&](int32_t p_begin, int32_t p_end) {
+		for (int32_t i = p_begin; i < p_end; ++i) {
+			JPH::Body* jolt_body = buoyant_bodies[i];
+			auto* body = reinterpret_cast<JoltBodyImpl3D*>(jolt_body->GetUserData());
+
+			body->apply_buoyancy(p_step, *jolt_body);
+		}
+	});
+
+	buoyant_bodies.clear();
+}
+
+void JoltSpace3D::_update_characters(float p_step) {
+	if (characters.is_empty()) {
+		return;
+	}
+
+	// The direct state is created lazily, so we make sure it exists before any of the jobs try to
+	// reach it through their query filters.
+	get_direct_state();
+
+	for (JoltCharacterImpl3D* character : characters) {
+		if (character->is_valid()) {
+			character->pre_step();
+		}
+	}
+
+	// Characters only ever read from the physics system, with the exception of pushing dynamic
+	// bodies, which goes through the locking body interface, so we can safely update them in
+	// parallel. The shared temporary allocator is not thread-safe though, so each job gets its own.
+	// Characters collide with each other through their kinematic bodies, which we only move once
+	// every character is done, so every character sees the others where they were at the start.
+	run_jobs("Characters", characters.size(), 4, [&](int32_t p_begin, int32_t p_end) {
+		JPH::TempAllocatorMalloc job_temp_allocator;
+
+		for (int32_t i = p_begin; i < p_end; ++i) {
+			JoltCharacterImpl3D* character = characters[i];
+
+			if (character->is_valid()) {
+				character->update(p_step, job_temp_allocator);
+			}
+		}
+	});
+
+	for (JoltCharacterImpl3D* character : characters) {
+		if (character->is_valid()) {
+			character->post_update(p_step);
+		}
+	}
+}
+
+void JoltSpace3D::_update_projectiles(float p_step) {
+	for (JoltProjectilePoolImpl3D* projectile_pool : projectile_pools) {
+		projectile_pool->step(p_step);
+	}
+}
+
+void JoltSpace3D::_evaluate_queries() {
+	_evaluate_async_queries();
+
+	if (queries.is_empty()) {
+		return;
+	}
+
+	const JoltPhysicsDirectSpaceState3DExtension& space_state = *get_direct_state();
+
+	// Queries only ever read from the physics system and write to their own cached results, so we
+	// can safely evaluate all of them in parallel.
+	run_jobs("Queries", queries.size(), 16, [&](int32_t p_begin, int32_t p_end) {
+		for (int32_t i = p_begin; i < p_end; ++i) {
+			queries[i]->evaluate(space_state);
+		}
+	});
+}
+
+void JoltSpace3D::_evaluate_async_queries() {
+	LocalVector<AsyncQuery> async_queries;
+
+	{
+		const MutexLock lock(async_queries_mutex);
+		std::swap(async_queries, pending_async_queries);
+	}
+
+	if (async_queries.is_empty()) {
+		return;
+	}
+
+	const JoltPhysicsDirectSpaceState3DExtension& space_state = *get_direct_state();
+
+	run_jobs("Async Queries", async_queries.size(), 16, [&](int32_t p_begin, int32_t p_end) {
+		for (int32_t i = p_begin; i < p_end; ++i) {
+			async_queries[i].query->evaluate(space_state);
+		}
+	});
+
+	const MutexLock lock(async_queries_mutex);
+
+	for (const AsyncQuery& async_query : async_queries) {
+		evaluated_async_queries.push_back(async_query);
+	}
+}
+
+void JoltSpace3D::_collect_async_queries() {
+	const MutexLock lock(async_queries_mutex);
+
+	async_collect_count += 1;
+
+	completed_async_queries.erase_if([&](auto& p_entry) {
+		AsyncQuery& async_query = p_entry.second;
+
+		if (async_collect_count - async_query.collected_at <= ASYNC_QUERY_RESULT_LIFETIME) {
+			return false;
+		}
+
+		memdelete_safely(async_query.query);
+
+		return true;
+	});
+
+	// We hold on to the results until the queries are flushed, rather than handing them out as
+	// soon as they're evaluated, so that they show up at a consistent point in the frame.
+	for (AsyncQuery& async_query : evaluated_async_queries) {
+		async_query.collected_at = async_collect_count;
+		completed_async_queries.insert(async_query.ticket, async_query);
+	}
+
+	evaluated_async_queries.clear();
+}
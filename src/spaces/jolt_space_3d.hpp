@@ -4,13 +4,29 @@
 
 class JoltAreaImpl3D;
 class JoltBodyActivationListener3D;
+class JoltCharacterImpl3D;
 class JoltContactListener3D;
 class JoltJointImpl3D;
 class JoltLayerMapper;
 class JoltObjectImpl3D;
+class JoltObjectLayerSet;
 class JoltPhysicsDirectSpaceState3DExtension;
+class JoltProjectilePoolImpl3D;
+class JoltQueryImpl3D;
 
 class JoltSpace3D {
+	using Mutex = std::mutex;
+
+	using MutexLock = std::unique_lock<Mutex>;
+
+	struct AsyncQuery {
+		JoltQueryImpl3D* query = nullptr;
+
+		int64_t ticket = 0;
+
+		int64_t collected_at = 0;
+	};
+
 public:
 	explicit JoltSpace3D(JPH::JobSystem* p_job_system);
 
@@ -57,6 +73,8 @@ public:
 		uint32_t& p_collision_mask
 	) const;
 
+	void get_object_layers_in_mask(uint32_t p_collision_mask, JoltObjectLayerSet& p_layers) const;
+
 	JoltReadableBody3D read_body(const JPH::BodyID& p_body_id) const;
 
 	JoltReadableBody3D read_body(const JoltObjectImpl3D& p_object) const;
@@ -91,6 +109,14 @@ public:
 
 	void try_optimize();
 
+	bool try_begin_query() const;
+
+	void end_query() const;
+
+	uint64_t get_query_cache_version() const { return query_cache_version; }
+
+	void invalidate_query_cache() { query_cache_version += 1; }
+
 	void add_joint(JPH::Constraint* p_jolt_ref);
 
 	void add_joint(JoltJointImpl3D* p_joint);
@@ -99,6 +125,32 @@ public:
 
 	void remove_joint(JoltJointImpl3D* p_joint);
 
+	void add_character(JoltCharacterImpl3D* p_character);
+
+	void remove_character(JoltCharacterImpl3D* p_character);
+
+	void add_query(JoltQueryImpl3D* p_query);
+
+	void remove_query(JoltQueryImpl3D* p_query);
+
+	void add_projectile_pool(JoltProjectilePoolImpl3D* p_pool);
+
+	void remove_projectile_pool(JoltProjectilePoolImpl3D* p_pool);
+
+	int64_t submit_async_query(JoltQueryImpl3D* p_query);
+
+	bool is_async_query_ready(int64_t p_ticket) const;
+
+	JoltQueryImpl3D* take_async_query(int64_t p_ticket);
+
+	template<typename TCallable>
+	void run_jobs(
+		const char* p_name,
+		int32_t p_count,
+		int32_t p_min_batch_size,
+		TCallable&& p_callable
+	) const;
+
 #ifdef GDJ_CONFIG_EDITOR
 	void dump_debug_snapshot(const String& p_dir);
 
@@ -116,8 +168,36 @@ private:
 
 	void _post_step(float p_step);
 
+	void _apply_buoyancy(float p_step);
+
+	void _update_characters(float p_step);
+
+	void _update_projectiles(float p_step);
+
+	void _evaluate_queries();
+
+	void _evaluate_async_queries();
+
+	void _collect_async_queries();
+
 	JoltBodyWriter3D body_accessor;
 
+	LocalVector<JPH::Body*> buoyant_bodies;
+
+	LocalVector<JoltCharacterImpl3D*> characters;
+
+	LocalVector<JoltQueryImpl3D*> queries;
+
+	LocalVector<JoltProjectilePoolImpl3D*> projectile_pools;
+
+	LocalVector<AsyncQuery> pending_async_queries;
+
+	LocalVector<AsyncQuery> evaluated_async_queries;
+
+	HashMap<int64_t, AsyncQuery> completed_async_queries;
+
+	mutable Mutex async_queries_mutex;
+
 	RID rid;
 
 	JPH::JobSystem* job_system = nullptr;
@@ -136,6 +216,16 @@ private:
 
 	JoltAreaImpl3D* default_area = nullptr;
 
+	mutable std::atomic<int32_t> active_queries = 0;
+
+	std::atomic<bool> stepping = false;
+
+	std::atomic<uint64_t> query_cache_version = 0;
+
+	int64_t next_async_ticket = 1;
+
+	int64_t async_collect_count = 0;
+
 	float last_step = 0.0f;
 
 	int32_t bodies_added_since_optimizing = 0;
@@ -144,3 +234,42 @@ private:
 
 	bool has_stepped = false;
 };
+
+template<typename TCallable>
+void JoltSpace3D::run_jobs(
+	const char* p_name,
+	int32_t p_count,
+	int32_t p_min_batch_size,
+	TCallable&& p_callable
+) const {
+	if (p_count <= 0) {
+		return;
+	}
+
+	const int32_t max_jobs = MAX(job_system->GetMaxConcurrency(), 1);
+	const int32_t job_count = CLAMP(p_count / MAX(p_min_batch_size, 1), 1, max_jobs);
+
+	if (job_count == 1) {
+		p_callable(0, p_count);
+		return;
+	}
+
+	const int32_t batch_size = (p_count + job_count - 1) / job_count;
+
+	JPH::JobSystem::Barrier* barrier = job_system->CreateBarrier();
+
+	for (int32_t begin = 0; begin < p_count; begin += batch_size) {
+		const int32_t end = MIN(begin + batch_size, p_count);
+
+		const JPH::JobHandle job = job_system->CreateJob(
+			p_name,
+			JPH::Color::sGreen,
+			[&p_callable, begin, end]() { p_callable(begin, end); }
+		);
+
+		barrier->AddJob(job);
+	}
+
+	job_system->WaitForJobs(barrier);
+	job_system->DestroyBarrier(barrier);
+}